@@ -0,0 +1,58 @@
+/**
+ * @file alloc_counter.cpp
+ * @brief The counting operator new behind allocationCount().
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "alloc_counter.hpp"
+
+#ifdef SNAKE_COUNT_ALLOCS
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace {
+
+// Constant-initialized, so allocations made before main or on any thread need no guard
+thread_local uint64_t allocations = 0;
+
+// Shared body of the replaced allocation functions
+void* countedAlloc(size_t size) {
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+// Returns the number of allocations the calling thread made so far
+uint64_t allocationCount() {
+    return allocations;
+}
+
+#else
+
+// Counting is compiled out
+uint64_t allocationCount() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * @file alloc_counter.hpp
+ * @brief Per-thread heap allocation counter for the profiler and the benchmarks.
+ * @details Builds with SNAKE_COUNT_ALLOCS defined (snake_bench, and the game
+ * when made with PROFILE=1) replace the global operator new with one that
+ * counts every allocation in a thread-local counter before calling malloc.
+ * Being per thread, the count of the game thread is not disturbed by the
+ * persistence worker or the startup loader, so a frame or round that reads
+ * zero really did not allocate. Other builds keep the standard operator new
+ * and report zero.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstdint>
+
+#ifdef SNAKE_COUNT_ALLOCS
+constexpr bool ALLOCATION_COUNTING = true;
+#else
+constexpr bool ALLOCATION_COUNTING = false;
+#endif
+
+// Heap allocations made by the calling thread so far; always 0 without ALLOCATION_COUNTING
+uint64_t allocationCount();
+
+#endif // ALLOC_COUNTER_HPP
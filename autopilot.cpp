@@ -0,0 +1,258 @@
+/**
+ * @file autopilot.cpp
+ * @brief Implementation of the path-planning autopilot.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "autopilot.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const int16_t OFFSET_X[4] = { 0, 0, -1, 1 };
+const int16_t OFFSET_Y[4] = { -1, 1, 0, 0 };
+
+} // namespace
+
+// Constructor: Sizes the buffers for the given board
+Autopilot::Autopilot(int width, int height)
+    : width(0), height(0), cellCount(0), stamp(0), plannedFood(NONE), replanDelay(0),
+      chasedFood(NONE), hungryTicks(0), searches(0), expanded(0) {
+    resize(width, height);
+}
+
+// Allocates every per-cell buffer once and rebuilds the cycle
+void Autopilot::resize(int newWidth, int newHeight) {
+    if (newWidth == width && newHeight == height) return;
+    width = newWidth;
+    height = newHeight;
+    cellCount = static_cast<uint32_t>(width) * height;
+
+    visited.assign(cellCount, 0);
+    parent.assign(cellCount, NONE);
+    frontier.assign(cellCount, 0);
+    path.clear();
+    path.reserve(cellCount);
+    stamp = 0;
+    buildCycle();
+    reset();
+}
+
+// Forgets the current plan
+void Autopilot::reset() {
+    path.clear();
+    plannedFood = NONE;
+    replanDelay = 0;
+    chasedFood = NONE;
+    hungryTicks = 0;
+}
+
+// Picks the move for the next tick
+Direction Autopilot::choose(const SnakeSim& sim) {
+    resize(sim.getWidth(), sim.getHeight());
+    uint32_t head = cellOf(sim.getSnake().front());
+    size_t length = sim.getSnake().size();
+    bool cycle = hasCycle() && sim.getObstacles().empty();
+
+    // From half the board on only the exact cycle is safe
+    if (cycle && 2 * length >= cellCount) return followCycle(sim, head);
+    if (!sim.hasFood()) return cycle ? followCycle(sim, head) : safestMove(sim, head);
+
+    uint32_t food = cellOf(sim.getFood());
+    if (food != chasedFood) {
+        chasedFood = food;
+        hungryTicks = 0;
+    }
+    // Without a cycle, food the room check keeps refusing (e.g. in a dead end) would leave the snake circling
+    // forever, so after a board's worth of ticks without eating the path is taken anyway and the round ends
+    bool desperate = ++hungryTicks > cellCount && !cycle;
+    if (replanDelay > 0) --replanDelay;
+    if (food != plannedFood && replanDelay == 0) {
+        path.clear();
+        plannedFood = food;
+        // The body may be walling the food off only for now, so a failed search is retried a few ticks on
+        if (!planPath(sim, head, food)) {
+            plannedFood = NONE;
+            replanDelay = REPLAN_INTERVAL;
+        }
+    }
+
+    if (!path.empty()) {
+        uint32_t next = path.back();
+        Position from = positionOf(head);
+        Position to = positionOf(next);
+        bool adjacent = std::abs(from.x - to.x) + std::abs(from.y - to.y) == 1;
+        bool safe = adjacent && !sim.isBlocked(to) && (desperate ||
+                    (cycle ? isCycleSafe(sim, head, next) : reachableCells(sim, next, length) >= length));
+        if (safe) {
+            path.pop_back();
+            return directionTo(from, to);
+        }
+        path.clear();
+        // The cycle still leads to this food, so searching again would not help; without one, retry next tick
+        if (!cycle) plannedFood = NONE;
+    }
+    return cycle ? followCycle(sim, head) : safestMove(sim, head);
+}
+
+// Builds a Hamiltonian cycle when one side is even: a zigzag over all but the first
+// column (or row) that returns along it; boards with two odd sides have no cycle
+void Autopilot::buildCycle() {
+    cycleOrder.clear();
+    cycleNext.clear();
+    bool rows = height % 2 == 0;
+    if (!rows && width % 2 != 0) return;
+
+    cycleNext.resize(cellCount);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int nx = x, ny = y;
+            if (rows) {
+                if (x == 0) (y == 0 ? nx : ny) += (y == 0 ? 1 : -1);
+                else if (y % 2 == 0) (x == width - 1 ? ny : nx) += 1;
+                else if (x == 1) { if (y == height - 1) nx -= 1; else ny += 1; }
+                else nx -= 1;
+            } else {
+                if (y == 0) (x == 0 ? ny : nx) += (x == 0 ? 1 : -1);
+                else if (x % 2 == 0) (y == height - 1 ? nx : ny) += 1;
+                else if (y == 1) { if (x == width - 1) ny -= 1; else nx += 1; }
+                else ny -= 1;
+            }
+            cycleNext[static_cast<uint32_t>(y) * width + x] = static_cast<uint32_t>(ny) * width + nx;
+        }
+    }
+
+    cycleOrder.assign(cellCount, NONE);
+    uint32_t cell = 0;
+    for (uint32_t order = 0; order < cellCount; ++order) {
+        cycleOrder[cell] = order;
+        cell = cycleNext[cell];
+    }
+}
+
+Position Autopilot::positionOf(uint32_t cell) const {
+    return { static_cast<int16_t>(cell % width), static_cast<int16_t>(cell / width) };
+}
+
+// Returns a stamp no cell carries yet, clearing the marks only when the counter wraps
+uint32_t Autopilot::nextStamp() {
+    if (++stamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        stamp = 1;
+    }
+    return stamp;
+}
+
+// Steps from one cell to another going forward along the cycle
+uint32_t Autopilot::cycleDistance(uint32_t from, uint32_t to) const {
+    return (cycleOrder[to] + cellCount - cycleOrder[from]) % cellCount;
+}
+
+// The body trails the head along the cycle, so a move may skip ahead as long as it
+// lands short of the tail with room left for the snake to grow
+bool Autopilot::isCycleSafe(const SnakeSim& sim, uint32_t head, uint32_t next) const {
+    uint32_t tail = cellOf(sim.getSnake().back());
+    return cycleDistance(head, next) + GROWTH_MARGIN < cycleDistance(head, tail);
+}
+
+// Breadth-first search from the head to the food; fills path when one exists
+bool Autopilot::planPath(const SnakeSim& sim, uint32_t head, uint32_t food) {
+    uint32_t mark = nextStamp();
+    size_t begin = 0, end = 0;
+    frontier[end++] = head;
+    visited[head] = mark;
+    ++searches;
+
+    bool found = false;
+    while (begin < end && !found) {
+        uint32_t cell = frontier[begin++];
+        Position pos = positionOf(cell);
+        for (int d = 0; d < 4; ++d) {
+            Position n = { static_cast<int16_t>(pos.x + OFFSET_X[d]), static_cast<int16_t>(pos.y + OFFSET_Y[d]) };
+            if (sim.isBlocked(n)) continue;
+            uint32_t ncell = cellOf(n);
+            if (visited[ncell] == mark) continue;
+            visited[ncell] = mark;
+            parent[ncell] = cell;
+            if (ncell == food) {
+                found = true;
+                break;
+            }
+            frontier[end++] = ncell;
+        }
+    }
+    expanded += begin;
+
+    if (!found) return false;
+    for (uint32_t cell = food; cell != head; cell = parent[cell]) path.push_back(cell);
+    return true;
+}
+
+// Counts free cells reachable from start, stopping at limit
+size_t Autopilot::reachableCells(const SnakeSim& sim, uint32_t start, size_t limit) {
+    uint32_t mark = nextStamp();
+    size_t begin = 0, end = 0;
+    frontier[end++] = start;
+    visited[start] = mark;
+    while (begin < end && end < limit) {
+        Position pos = positionOf(frontier[begin++]);
+        for (int d = 0; d < 4; ++d) {
+            Position n = { static_cast<int16_t>(pos.x + OFFSET_X[d]), static_cast<int16_t>(pos.y + OFFSET_Y[d]) };
+            if (sim.isBlocked(n)) continue;
+            uint32_t ncell = cellOf(n);
+            if (visited[ncell] == mark) continue;
+            visited[ncell] = mark;
+            frontier[end++] = ncell;
+        }
+    }
+    return end;
+}
+
+// Follows the cycle, taking the furthest safe shortcut that does not pass the food while the snake is short
+Direction Autopilot::followCycle(const SnakeSim& sim, uint32_t head) {
+    uint32_t best = cycleNext[head];
+    if (2 * sim.getSnake().size() < cellCount && sim.hasFood()) {
+        uint32_t toFood = cycleDistance(head, cellOf(sim.getFood()));
+        uint32_t bestDistance = 1;
+        Position pos = positionOf(head);
+        for (int d = 0; d < 4; ++d) {
+            Position n = { static_cast<int16_t>(pos.x + OFFSET_X[d]), static_cast<int16_t>(pos.y + OFFSET_Y[d]) };
+            if (sim.isBlocked(n)) continue;
+            uint32_t ncell = cellOf(n);
+            uint32_t distance = cycleDistance(head, ncell);
+            if (distance > bestDistance && distance <= toFood && isCycleSafe(sim, head, ncell)) {
+                best = ncell;
+                bestDistance = distance;
+            }
+        }
+    }
+    // Off the cycle (e.g. right after the start) the successor may be taken; survive instead
+    if (sim.isBlocked(positionOf(best))) return safestMove(sim, head);
+    return directionTo(positionOf(head), positionOf(best));
+}
+
+// Moves into the free neighbour that opens onto the most room, up to the snake's length
+Direction Autopilot::safestMove(const SnakeSim& sim, uint32_t head) {
+    Position pos = positionOf(head);
+    Direction best = sim.getDirection();
+    size_t bestRoom = 0;
+    size_t limit = sim.getSnake().size() + 1;
+    for (int d = 0; d < 4; ++d) {
+        Position n = { static_cast<int16_t>(pos.x + OFFSET_X[d]), static_cast<int16_t>(pos.y + OFFSET_Y[d]) };
+        if (sim.isBlocked(n)) continue;
+        size_t room = reachableCells(sim, cellOf(n), limit);
+        if (room > bestRoom) {
+            bestRoom = room;
+            best = directionTo(pos, n);
+        }
+    }
+    return best;
+}
+
+Direction Autopilot::directionTo(Position from, Position to) {
+    if (to.x < from.x) return Direction::LEFT;
+    if (to.x > from.x) return Direction::RIGHT;
+    return to.y < from.y ? Direction::UP : Direction::DOWN;
+}
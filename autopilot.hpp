@@ -0,0 +1,77 @@
+/**
+ * @file autopilot.hpp
+ * @brief Path-planning player for demos, benchmarks and headless runs.
+ * @details The autopilot plans a shortest path to the food with a
+ * breadth-first search over the simulation's occupancy grid and follows it
+ * until the food is eaten, so the search runs once per food rather than
+ * once per tick; a search that finds no way through the body is retried
+ * every few ticks as the tail moves out of the way. On boards without
+ * obstacles and with an even side it also keeps a Hamiltonian cycle through every cell: while the snake is short,
+ * path steps are only taken when they skip ahead along the cycle without
+ * overtaking the tail, and once the snake covers half the board it follows
+ * the cycle exactly, which is guaranteed to fill the board. Without a
+ * cycle, a step is only taken when the region it leads into can hold the
+ * snake, unless the snake has gone a board's worth of ticks without eating,
+ * when the path is taken regardless so a round cannot circle forever.
+ * Every buffer is sized by resize(), so choose() never allocates.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef AUTOPILOT_HPP
+#define AUTOPILOT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "snake_sim.hpp"
+
+class Autopilot {
+public:
+    Autopilot(int width = SnakeSim::DEFAULT_WIDTH, int height = SnakeSim::DEFAULT_HEIGHT);
+
+    void resize(int width, int height);  // Reallocates the planning buffers if the size changed
+    void reset();                        // Drops the planned path; call when a round starts
+    Direction choose(const SnakeSim& sim);
+
+    // Statistics
+    uint64_t getSearches() const { return searches; }
+    uint64_t getExpanded() const { return expanded; }
+    bool hasCycle() const { return !cycleOrder.empty(); }
+
+private:
+    int width;
+    int height;
+    uint32_t cellCount;
+    std::vector<uint32_t> cycleOrder;  // Position of each cell along the cycle; empty without one
+    std::vector<uint32_t> cycleNext;   // Cell that follows each cell on the cycle
+    std::vector<uint32_t> visited;     // Search stamp per cell; a new search bumps the stamp instead of clearing
+    std::vector<uint32_t> parent;      // Predecessor of each reached cell in the last search
+    std::vector<uint32_t> frontier;    // Search queue, one slot per cell
+    std::vector<uint32_t> path;        // Planned cells, food first; back() is the next step
+    uint32_t stamp;
+    uint32_t plannedFood;              // Food cell the path leads to, or NONE
+    uint32_t replanDelay;              // Ticks left before a failed search is tried again
+    uint32_t chasedFood;               // Food cell hungryTicks counts for
+    uint32_t hungryTicks;              // Ticks since that food appeared
+    uint64_t searches;
+    uint64_t expanded;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t GROWTH_MARGIN = 4;  // Free cycle cells kept ahead of the tail when skipping
+    static constexpr uint32_t REPLAN_INTERVAL = 8; // Ticks between searches while the food is out of reach
+
+    void buildCycle();
+    uint32_t cellOf(Position pos) const { return static_cast<uint32_t>(pos.y) * width + pos.x; }
+    Position positionOf(uint32_t cell) const;
+    uint32_t nextStamp();
+    uint32_t cycleDistance(uint32_t from, uint32_t to) const;
+    bool isCycleSafe(const SnakeSim& sim, uint32_t head, uint32_t next) const;
+    bool planPath(const SnakeSim& sim, uint32_t head, uint32_t food);
+    size_t reachableCells(const SnakeSim& sim, uint32_t start, size_t limit);
+    Direction followCycle(const SnakeSim& sim, uint32_t head);
+    Direction safestMove(const SnakeSim& sim, uint32_t head);
+    static Direction directionTo(Position from, Position to);
+};
+
+#endif // AUTOPILOT_HPP
@@ -0,0 +1,143 @@
+/**
+ * @file batch_kernels.cpp
+ * @brief Scalar, AVX2 and NEON implementations of the batch head-update kernel.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "batch_kernels.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SNAKE_KERNEL_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#define SNAKE_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Directions are UP=0, DOWN=1, LEFT=2, RIGHT=3: bit 1 selects the axis and bit 0 the sign,
+// and a request reverses the heading exactly when the two differ in bit 0 alone
+
+// Reference kernel and tail handler for the vector ones
+void stepLanesScalar(const StepLanes& lanes, size_t begin, size_t end, int16_t width, int16_t height) {
+    for (size_t i = begin; i < end; ++i) {
+        uint8_t direction = lanes.directions[i];
+        uint8_t requested = lanes.requested[i];
+        uint8_t resolved = (direction ^ requested) == 1 ? direction : requested;
+        int16_t sign = static_cast<int16_t>((resolved & 1) * 2 - 1);
+        int16_t x = static_cast<int16_t>(lanes.headX[i] + (resolved & 2 ? sign : 0));
+        int16_t y = static_cast<int16_t>(lanes.headY[i] + (resolved & 2 ? 0 : sign));
+
+        bool outside = x < 0 || x >= width || y < 0 || y >= height;
+        bool eats = x == lanes.foodX[i] && y == lanes.foodY[i];
+        lanes.resolved[i] = resolved;
+        lanes.nextX[i] = x;
+        lanes.nextY[i] = y;
+        lanes.flags[i] = static_cast<uint8_t>((outside ? LANE_OUTSIDE : 0) | (eats ? LANE_EATS : 0));
+    }
+}
+
+void runScalar(const StepLanes& lanes, size_t count, int16_t width, int16_t height) {
+    stepLanesScalar(lanes, 0, count, width, height);
+}
+
+#ifdef SNAKE_KERNEL_AVX2
+// Sixteen environments per iteration in 16-bit lanes
+__attribute__((target("avx2")))
+void runAvx2(const StepLanes& lanes, size_t count, int16_t width, int16_t height) {
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i minusOne = _mm256_set1_epi16(-1);
+    const __m256i two = _mm256_set1_epi16(2);
+    const __m256i boardWidth = _mm256_set1_epi16(width);
+    const __m256i boardHeight = _mm256_set1_epi16(height);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i direction = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.directions + i)));
+        __m256i requested = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.requested + i)));
+        __m256i reverse = _mm256_cmpeq_epi16(_mm256_xor_si256(direction, requested), one);
+        __m256i resolved = _mm256_blendv_epi8(requested, direction, reverse);
+
+        __m256i sign = _mm256_sub_epi16(_mm256_slli_epi16(_mm256_and_si256(resolved, one), 1), one);
+        __m256i horizontal = _mm256_cmpeq_epi16(_mm256_and_si256(resolved, two), two);
+        __m256i x = _mm256_add_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.headX + i)),
+                                     _mm256_and_si256(horizontal, sign));
+        __m256i y = _mm256_add_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.headY + i)),
+                                     _mm256_andnot_si256(horizontal, sign));
+
+        __m256i inside = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi16(x, minusOne), _mm256_cmpgt_epi16(boardWidth, x)),
+                                          _mm256_and_si256(_mm256_cmpgt_epi16(y, minusOne), _mm256_cmpgt_epi16(boardHeight, y)));
+        __m256i eats = _mm256_and_si256(
+            _mm256_cmpeq_epi16(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.foodX + i))),
+            _mm256_cmpeq_epi16(y, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.foodY + i))));
+        __m256i flags = _mm256_or_si256(_mm256_andnot_si256(inside, one), _mm256_and_si256(eats, two));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.nextX + i), x);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.nextY + i), y);
+        // packus works per 128-bit half; the permute gathers both halves' bytes into the low 16
+        __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(resolved, flags), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.resolved + i), _mm256_castsi256_si128(bytes));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.flags + i), _mm256_extracti128_si256(bytes, 1));
+    }
+    stepLanesScalar(lanes, i, count, width, height);
+}
+#endif
+
+#ifdef SNAKE_KERNEL_NEON
+// Eight environments per iteration in 16-bit lanes
+void runNeon(const StepLanes& lanes, size_t count, int16_t width, int16_t height) {
+    const int16x8_t one = vdupq_n_s16(1);
+    const int16x8_t two = vdupq_n_s16(2);
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t boardWidth = vdupq_n_s16(width);
+    const int16x8_t boardHeight = vdupq_n_s16(height);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t direction = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(lanes.directions + i)));
+        int16x8_t requested = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(lanes.requested + i)));
+        uint16x8_t reverse = vceqq_s16(veorq_s16(direction, requested), one);
+        int16x8_t resolved = vbslq_s16(reverse, direction, requested);
+
+        int16x8_t sign = vsubq_s16(vshlq_n_s16(vandq_s16(resolved, one), 1), one);
+        int16x8_t horizontal = vreinterpretq_s16_u16(vceqq_s16(vandq_s16(resolved, two), two));
+        int16x8_t x = vaddq_s16(vld1q_s16(lanes.headX + i), vandq_s16(sign, horizontal));
+        int16x8_t y = vaddq_s16(vld1q_s16(lanes.headY + i), vbicq_s16(sign, horizontal));
+
+        uint16x8_t inside = vandq_u16(vandq_u16(vcgeq_s16(x, zero), vcltq_s16(x, boardWidth)),
+                                      vandq_u16(vcgeq_s16(y, zero), vcltq_s16(y, boardHeight)));
+        uint16x8_t eats = vandq_u16(vceqq_s16(x, vld1q_s16(lanes.foodX + i)), vceqq_s16(y, vld1q_s16(lanes.foodY + i)));
+        uint16x8_t flags = vorrq_u16(vbicq_u16(vdupq_n_u16(LANE_OUTSIDE), inside), vandq_u16(eats, vdupq_n_u16(LANE_EATS)));
+
+        vst1q_s16(lanes.nextX + i, x);
+        vst1q_s16(lanes.nextY + i, y);
+        vst1_u8(lanes.resolved + i, vmovn_u16(vreinterpretq_u16_s16(resolved)));
+        vst1_u8(lanes.flags + i, vmovn_u16(flags));
+    }
+    stepLanesScalar(lanes, i, count, width, height);
+}
+#endif
+
+} // namespace
+
+// Lists the kernels usable on this CPU; AVX2 is probed at run time, NEON is part of every ARMv8 target
+std::vector<StepKernel> getSupportedStepKernels() {
+    std::vector<StepKernel> kernels;
+#ifdef SNAKE_KERNEL_AVX2
+    if (__builtin_cpu_supports("avx2")) kernels.push_back({ "avx2", runAvx2 });
+#endif
+#ifdef SNAKE_KERNEL_NEON
+    kernels.push_back({ "neon", runNeon });
+#endif
+    kernels.push_back({ "scalar", runScalar });
+    return kernels;
+}
+
+// Returns the first supported kernel, probing the CPU only once
+const StepKernel& getStepKernel() {
+    static const StepKernel kernel = getSupportedStepKernels().front();
+    return kernel;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file batch_kernels.hpp
+ * @brief Vectorized head-update kernels for BatchSim's structure-of-arrays state.
+ * @details Every tick, each environment resolves its requested direction
+ * against the current one, moves its head one cell, checks the new head
+ * against the board bounds and compares it with the food. That arithmetic
+ * is identical across environments, so BatchSim runs it for all of them at
+ * once over its SoA lanes before committing each board's step. Kernels
+ * exist for AVX2 (16 environments per instruction), NEON (8) and plain
+ * scalar code; getStepKernel() picks the best one the CPU supports the
+ * first time it is called. The occupancy test stays per board, since every
+ * environment has its own grid.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef BATCH_KERNELS_HPP
+#define BATCH_KERNELS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Per-lane outcome bits written by a kernel
+constexpr uint8_t LANE_OUTSIDE = 1;  // The new head left the board
+constexpr uint8_t LANE_EATS = 2;     // The new head is on the food
+
+// Views of the per-environment arrays a kernel reads and writes; directions are Direction values
+struct StepLanes {
+    const int16_t* headX;
+    const int16_t* headY;
+    const int16_t* foodX;
+    const int16_t* foodY;
+    const uint8_t* directions;  // Current heading
+    const uint8_t* requested;   // Action for this tick
+    uint8_t* resolved;          // Heading after the reversal filter
+    int16_t* nextX;
+    int16_t* nextY;
+    uint8_t* flags;             // LANE_OUTSIDE | LANE_EATS
+};
+
+struct StepKernel {
+    const char* name;
+    void (*run)(const StepLanes& lanes, size_t count, int16_t width, int16_t height);
+};
+
+const StepKernel& getStepKernel();                // Fastest kernel this CPU can run, chosen once
+std::vector<StepKernel> getSupportedStepKernels(); // Every kernel this CPU can run, fastest first
+
+#endif // BATCH_KERNELS_HPP
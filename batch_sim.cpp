@@ -0,0 +1,114 @@
+/**
+ * @file batch_sim.cpp
+ * @brief Implementation of the lockstep multi-environment simulator.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "batch_sim.hpp"
+
+// Constructor: Creates count identical boards with the given obstacles, all reset and alive
+BatchSim::BatchSim(size_t count, int width, int height, const std::vector<Position>& obstacles, EpisodeSource* source)
+    : envs(count, SnakeSim(width, height)),
+      headX(count), headY(count), foodX(count), foodY(count), directions(count),
+      scores(count), alive(count), results(count), done(count), finalScores(count), episodeTicks(count),
+      requested(count), resolved(count), nextX(count), nextY(count), flags(count), stepKernel(getStepKernel()),
+      episodeSource(source), maxEpisodeTicks(0), aliveCount(0), nextSeed(0),
+      episodesFinished(0), totalTicks(0) {
+    if (!obstacles.empty()) {
+        for (auto& env : envs) env.setObstacles(obstacles);
+    }
+    resetAll();
+}
+
+// Loads one obstacle layout and shares it across every environment
+// A binary level brings its own board size, so every environment is resized with it; a missing file clears them
+bool BatchSim::loadObstacles(const std::string& filename) {
+    if (envs.empty()) return false;
+    Level level;
+    if (!loadLevel(filename, envs[0].getWidth(), envs[0].getHeight(), level)) {
+        setObstacles({});
+        return false;
+    }
+    for (auto& env : envs) env.setLevel(level);
+    resetAll();
+    return true;
+}
+
+// Applies an obstacle layout to every environment and restarts them
+void BatchSim::setObstacles(const std::vector<Position>& layout) {
+    for (auto& env : envs) env.setObstacles(layout);
+    resetAll();
+}
+
+// Starts a fresh episode on every environment
+void BatchSim::resetAll() {
+    aliveCount = 0;
+    for (size_t i = 0; i < envs.size(); ++i) {
+        done[i] = 0;
+        finalScores[i] = 0;
+        startEpisode(i);
+    }
+}
+
+// Steps every live environment with its own action; finished episodes restart in place
+void BatchSim::stepAll(const Direction* actions) {
+    if (envs.empty()) return;
+    for (size_t i = 0; i < envs.size(); ++i) requested[i] = static_cast<uint8_t>(actions[i]);
+    StepLanes lanes = { headX.data(), headY.data(), foodX.data(), foodY.data(), directions.data(), requested.data(),
+                        resolved.data(), nextX.data(), nextY.data(), flags.data() };
+    stepKernel.run(lanes, envs.size(), static_cast<int16_t>(envs[0].getWidth()), static_cast<int16_t>(envs[0].getHeight()));
+
+    for (size_t i = 0; i < envs.size(); ++i) {
+        done[i] = 0;
+        if (!alive[i]) continue;
+
+        StepResult result = envs[i].advance(static_cast<Direction>(resolved[i]), { nextX[i], nextY[i] },
+                                            (flags[i] & LANE_OUTSIDE) != 0, (flags[i] & LANE_EATS) != 0);
+        results[i] = static_cast<uint8_t>(result);
+        ++episodeTicks[i];
+        ++totalTicks;
+
+        bool ended = result == StepResult::DIED || result == StepResult::CLEARED ||
+                     (maxEpisodeTicks > 0 && episodeTicks[i] >= maxEpisodeTicks);
+        if (ended) {
+            done[i] = 1;
+            finalScores[i] = envs[i].getScore();
+            ++episodesFinished;
+            if (episodeSource) episodeSource->episodeEnded(i, finalScores[i], episodeTicks[i]);
+            --aliveCount;
+            startEpisode(i);
+        } else {
+            syncEnv(i);
+        }
+    }
+}
+
+// Seeds and resets one environment, or parks it if the episode source is exhausted
+void BatchSim::startEpisode(size_t i) {
+    uint64_t seed = nextSeed++;
+    if (episodeSource && !episodeSource->nextEpisode(i, seed)) {
+        alive[i] = 0;
+        return;
+    }
+    envs[i].seed(seed);
+    envs[i].reset();
+    results[i] = static_cast<uint8_t>(StepResult::MOVED);
+    episodeTicks[i] = 0;
+    alive[i] = 1;
+    ++aliveCount;
+    syncEnv(i);
+}
+
+// Copies one environment's state into the structure-of-arrays views
+void BatchSim::syncEnv(size_t i) {
+    const SnakeSim& env = envs[i];
+    Position head = env.getSnake().front();
+    Position food = env.getFood();
+    headX[i] = head.x;
+    headY[i] = head.y;
+    foodX[i] = food.x;
+    foodY[i] = food.y;
+    directions[i] = static_cast<uint8_t>(env.getDirection());
+    scores[i] = env.getScore();
+}
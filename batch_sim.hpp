@@ -0,0 +1,111 @@
+/**
+ * @file batch_sim.hpp
+ * @brief Lockstep simulator for many independent Snake boards.
+ * @details BatchSim advances N boards per call with one action each and
+ * publishes the per-environment state in structure-of-arrays form, which is
+ * what training code and vectorized kernels want to consume. Every board is
+ * a SnakeSim, so the rules are exactly those of the interactive game.
+ * Each tick first runs a vectorized kernel over the SoA lanes to resolve
+ * every board's heading, new head, bounds and food test, then commits the
+ * boards one by one. Environments that die, clear their board or hit the
+ * tick limit are reset automatically, optionally asking an EpisodeSource
+ * for the next seed.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef BATCH_SIM_HPP
+#define BATCH_SIM_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "snake_sim.hpp"
+#include "batch_kernels.hpp"
+
+/**
+ * @brief Supplies episodes to a BatchSim as environments finish.
+ * @details Lets a scheduler decide which episode (and seed) each
+ * environment runs next, or park the environment when no work is left.
+ */
+class EpisodeSource {
+public:
+    virtual ~EpisodeSource() = default;
+    // Returns false to park the environment, otherwise sets the next episode's seed
+    virtual bool nextEpisode(size_t env, uint64_t& seed) = 0;
+    // Called when the episode running on env ends
+    virtual void episodeEnded(size_t env, int32_t score, uint32_t ticks) = 0;
+};
+
+class BatchSim {
+public:
+    // The obstacles and episode source given here are in place for the one reset the constructor does
+    BatchSim(size_t count, int width = SnakeSim::DEFAULT_WIDTH, int height = SnakeSim::DEFAULT_HEIGHT,
+             const std::vector<Position>& obstacles = {}, EpisodeSource* source = nullptr);
+
+    // Simulation
+    bool loadObstacles(const std::string& filename);  // Same formats as SnakeSim::loadObstacles
+    void setObstacles(const std::vector<Position>& layout);
+    void setEpisodeSource(EpisodeSource* source) { episodeSource = source; }
+    void setMaxEpisodeTicks(uint32_t ticks) { maxEpisodeTicks = ticks; }
+    void setStepKernel(const StepKernel& kernel) { stepKernel = kernel; }  // Defaults to getStepKernel()
+    void resetAll();
+    void stepAll(const Direction* actions);
+
+    // Accessors
+    size_t size() const { return envs.size(); }
+    const SnakeSim& getEnv(size_t i) const { return envs[i]; }
+    uint64_t getEpisodesFinished() const { return episodesFinished; }
+    uint64_t getTotalTicks() const { return totalTicks; }
+    size_t getAliveCount() const { return aliveCount; }
+    const char* getStepKernelName() const { return stepKernel.name; }
+
+    // Structure-of-arrays state, refreshed by resetAll() and stepAll()
+    const int16_t* getHeadX() const { return headX.data(); }
+    const int16_t* getHeadY() const { return headY.data(); }
+    const int16_t* getFoodX() const { return foodX.data(); }
+    const int16_t* getFoodY() const { return foodY.data(); }
+    const uint8_t* getDirections() const { return directions.data(); }
+    const int32_t* getScores() const { return scores.data(); }
+    const uint8_t* getAlive() const { return alive.data(); }             // Zero once an environment is parked
+    const uint8_t* getResults() const { return results.data(); }         // StepResult of the last step
+    const uint8_t* getDone() const { return done.data(); }               // Episode ended on the last step
+    const int32_t* getFinalScores() const { return finalScores.data(); } // Score of the episode that ended
+    const uint32_t* getEpisodeTicks() const { return episodeTicks.data(); }
+
+private:
+    std::vector<SnakeSim> envs;
+
+    std::vector<int16_t> headX;
+    std::vector<int16_t> headY;
+    std::vector<int16_t> foodX;
+    std::vector<int16_t> foodY;
+    std::vector<uint8_t> directions;
+    std::vector<int32_t> scores;
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> results;
+    std::vector<uint8_t> done;
+    std::vector<int32_t> finalScores;
+    std::vector<uint32_t> episodeTicks;
+
+    // Kernel inputs and outputs for the tick in progress
+    std::vector<uint8_t> requested;
+    std::vector<uint8_t> resolved;
+    std::vector<int16_t> nextX;
+    std::vector<int16_t> nextY;
+    std::vector<uint8_t> flags;
+    StepKernel stepKernel;
+
+    EpisodeSource* episodeSource;
+    uint32_t maxEpisodeTicks;
+    size_t aliveCount;
+    uint64_t nextSeed;
+    uint64_t episodesFinished;
+    uint64_t totalTicks;
+
+    void startEpisode(size_t i);
+    void syncEnv(size_t i);
+};
+
+#endif // BATCH_SIM_HPP
@@ -0,0 +1,480 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks for the simulation core, level files and the score store.
+ * @details Every benchmark calls the game's own code: SnakeSim::step (and
+ * through it moveSnake and the collision test), BatchSim ticks with each
+ * supported head-update kernel, checkCollision and generateFood directly,
+ * level loading in both file formats, switching between preloaded pack
+ * levels, autopilot rounds, multiplayer match ticks with the size of their
+ * encoded deltas, and the score store's load, query and record
+ * paths on generated files. Before the batch timings it runs every
+ * vectorized kernel in lockstep with the scalar one and exits non-zero if
+ * any lane differs after any tick. It also plays rounds the way the game
+ * loop does and exits non-zero if any round after the first allocates, so
+ * `make bench` fails on either regression. Seeds and iteration counts are fixed, and each
+ * result is printed as one "name  parameter  unit  value" row so the output
+ * can be diffed across releases; a comment line names the step kernel the
+ * CPU selected. Renderer frame rates need a window and are measured by
+ * `snake_game --bench-render`.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+#include "snake_sim.hpp"
+#include "batch_sim.hpp"
+#include "batch_kernels.hpp"
+#include "level.hpp"
+#include "level_pack.hpp"
+#include "autopilot.hpp"
+#include "match_sim.hpp"
+#include "net_protocol.hpp"
+#include "leaderboard.hpp"
+#include "score_store.hpp"
+#include "persistence.hpp"
+#include "rng.hpp"
+#include "replay.hpp"
+#include "input_queue.hpp"
+#include "alloc_counter.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile uint64_t sink;  // Keeps measured results observable
+
+// Prints one result row
+void report(const char* name, const std::string& parameter, const char* unit, double value) {
+    std::printf("%-20s %-18s %-8s %14.2f\n", name, parameter.c_str(), unit, value);
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Direction along a Hamiltonian cycle of a board with even height: rows are swept
+// in a zigzag over columns 1..width-1 and column 0 leads back to the top
+Direction cycleDirection(Position head, int width, int height) {
+    if (head.x == 0) return head.y == 0 ? Direction::RIGHT : Direction::UP;
+    if (head.y % 2 == 0) return head.x == width - 1 ? Direction::DOWN : Direction::RIGHT;
+    if (head.x == 1) return head.y == height - 1 ? Direction::LEFT : Direction::DOWN;
+    return Direction::LEFT;
+}
+
+// Follows the cycle until the snake has at least length segments
+void growSnake(SnakeSim& sim, size_t length) {
+    while (sim.getSnake().size() < length) {
+        sim.step(cycleDirection(sim.getSnake().front(), sim.getWidth(), sim.getHeight()));
+    }
+}
+
+std::vector<Position> randomObstacles(int width, int height, size_t count, uint64_t seed) {
+    Rng rng;
+    rng.seed(seed);
+    std::vector<Position> layout;
+    for (size_t i = 0; i < count; ++i) {
+        layout.push_back({static_cast<int16_t>(rng.nextBelow(width)), static_cast<int16_t>(rng.nextBelow(height))});
+    }
+    return layout;
+}
+
+// Full game ticks along the cycle: moves, eating, growth and a reset after each cleared board
+void benchStep(int width, int height, uint64_t ticks) {
+    SnakeSim sim(width, height);
+    sim.seed(1);
+    sim.reset();
+
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < ticks; ++i) {
+        StepResult result = sim.step(cycleDirection(sim.getSnake().front(), width, height));
+        if (result == StepResult::DIED || result == StepResult::CLEARED) sim.reset();
+    }
+    double seconds = secondsSince(start);
+    sink = sim.getScore();
+    report("sim.step", std::to_string(width) + "x" + std::to_string(height), "ticks/s", ticks / seconds);
+}
+
+// Cost of placing food once the snake covers part of the board
+void benchFoodSpawn(size_t length, uint64_t calls) {
+    SnakeSim sim;
+    sim.seed(2);
+    sim.reset();
+    growSnake(sim, length);
+
+    auto start = Clock::now();
+    uint64_t placed = 0;
+    for (uint64_t i = 0; i < calls; ++i) placed += sim.generateFood();
+    double seconds = secondsSince(start);
+    sink = placed;
+    report("food.spawn", "len=" + std::to_string(sim.getSnake().size()), "ns/op", seconds * 1e9 / calls);
+}
+
+// Cost of the head collision test as obstacles are added to a large board
+void benchCollision(size_t obstacles, uint64_t calls) {
+    SnakeSim sim(256, 256);
+    sim.setObstacles(randomObstacles(256, 256, obstacles, 3));
+    sim.seed(3);
+    sim.reset();
+
+    auto start = Clock::now();
+    uint64_t hits = 0;
+    for (uint64_t i = 0; i < calls; ++i) hits += sim.checkCollision();
+    double seconds = secondsSince(start);
+    sink = hits;
+    report("collision", "obstacles=" + std::to_string(sim.getObstacles().size()), "ns/op", seconds * 1e9 / calls);
+}
+
+// Load time of a level with one obstacle in eight cells, from the text list and from a binary bitmap
+void benchLevelLoad(int size, int reps) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string textFile = (dir / "snake_bench_level.txt").string();
+    std::string binaryFile = (dir / "snake_bench_level.lvl").string();
+
+    SnakeSim sim(size, size);
+    std::vector<Position> layout = randomObstacles(size, size, static_cast<size_t>(size) * size / 8, 5);
+    std::string text;
+    for (const auto& pos : layout) text += std::to_string(pos.x) + " " + std::to_string(pos.y) + "\n";
+    writeFileAtomic(textFile, text);
+    Level level;
+    loadLevel(textFile, size, size, level);
+    saveLevel(level, binaryFile);
+
+    std::string parameter = "size=" + std::to_string(size) + "x" + std::to_string(size);
+    auto start = Clock::now();
+    for (int i = 0; i < reps; ++i) sim.loadObstacles(textFile);
+    report("level.load.text", parameter, "ms", secondsSince(start) * 1e3 / reps);
+
+    start = Clock::now();
+    for (int i = 0; i < reps; ++i) sim.loadObstacles(binaryFile);
+    report("level.load.binary", parameter, "ms", secondsSince(start) * 1e3 / reps);
+    sink = sim.getObstacles().size();
+
+    std::filesystem::remove(textFile);
+    std::filesystem::remove(binaryFile);
+}
+
+// Switching between two preloaded pack levels of the board's size, as reset() does between rounds
+void benchLevelSwitch(int size, int reps) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "snake_bench_pack";
+    std::filesystem::create_directories(dir);
+    for (uint64_t seed : {6, 7}) {
+        Level level;
+        level.width = size;
+        level.height = size;
+        level.cells = OccupancyGrid(static_cast<size_t>(size) * size);
+        for (const auto& pos : randomObstacles(size, size, static_cast<size_t>(size) * size / 8, seed)) {
+            level.cells.set(static_cast<size_t>(pos.y) * size + pos.x);
+        }
+        saveLevel(level, (dir / ("level" + std::to_string(seed) + ".lvl")).string());
+    }
+
+    LevelPack pack;
+    pack.open(dir.string(), size, size);
+    pack.wait();
+    SnakeSim sim(size, size);
+    sim.reserveObstacles(static_cast<size_t>(size) * size / 8);
+
+    auto start = Clock::now();
+    for (int i = 0; i < reps; ++i) {
+        if (const Level* level = pack.get(i % pack.size())) sim.setLevel(*level);
+    }
+    report("level.switch", "size=" + std::to_string(size) + "x" + std::to_string(size), "us/op", secondsSince(start) * 1e6 / reps);
+    sink = sim.getObstacles().size();
+
+    std::filesystem::remove_all(dir);
+}
+
+// Lets the autopilot play one round on an empty board, up to maxTicks; reports the planning
+// cost per tick and the length the snake reached
+void benchAutopilot(int width, int height, uint64_t maxTicks) {
+    SnakeSim sim(width, height);
+    sim.seed(8);
+    sim.reset();
+    Autopilot autopilot(width, height);
+
+    uint64_t ticks = 0;
+    auto start = Clock::now();
+    while (ticks < maxTicks) {
+        ++ticks;
+        StepResult result = sim.step(autopilot.choose(sim));
+        if (result == StepResult::DIED || result == StepResult::CLEARED) break;
+    }
+    double seconds = secondsSince(start);
+    std::string parameter = std::to_string(width) + "x" + std::to_string(height);
+    report("autopilot.tick", parameter, "us/op", seconds * 1e6 / ticks);
+    report("autopilot.length", parameter, "cells", static_cast<double>(sim.getSnake().size()));
+    sink = autopilot.getExpanded();
+}
+
+// Runs the batch head-update kernel alone and then whole BatchSim ticks with every kernel the CPU
+// supports; actions are pre-generated so only the simulator is timed
+void benchBatchStep(size_t envs, int ticks) {
+    Rng rng;
+    rng.seed(9);
+    std::vector<std::vector<Direction>> actions(64, std::vector<Direction>(envs));
+    for (auto& tick : actions) {
+        for (auto& action : tick) action = static_cast<Direction>(rng.nextBelow(4));
+    }
+    std::string count = "envs=" + std::to_string(envs);
+
+    for (const StepKernel& kernel : getSupportedStepKernels()) {
+        BatchSim batch(envs);
+        batch.setStepKernel(kernel);
+        batch.setMaxEpisodeTicks(200);
+
+        std::vector<uint8_t> requested(envs), resolved(envs), flags(envs);
+        std::vector<int16_t> nextX(envs), nextY(envs);
+        for (size_t i = 0; i < envs; ++i) requested[i] = static_cast<uint8_t>(actions[0][i]);
+        StepLanes lanes = { batch.getHeadX(), batch.getHeadY(), batch.getFoodX(), batch.getFoodY(), batch.getDirections(),
+                            requested.data(), resolved.data(), nextX.data(), nextY.data(), flags.data() };
+        auto start = Clock::now();
+        for (int i = 0; i < ticks; ++i) kernel.run(lanes, envs, SnakeSim::DEFAULT_WIDTH, SnakeSim::DEFAULT_HEIGHT);
+        report("batch.kernel", std::string(kernel.name) + " " + count, "ns/env", secondsSince(start) * 1e9 / (static_cast<double>(ticks) * envs));
+        sink = flags[envs - 1];
+
+        start = Clock::now();
+        for (int i = 0; i < ticks; ++i) batch.stepAll(actions[i % actions.size()].data());
+        report("batch.step", std::string(kernel.name) + " " + count, "ticks/s", batch.getTotalTicks() / secondsSince(start));
+    }
+}
+
+// Lockstep check that every vectorized kernel plays exactly like the scalar one: one seeded BatchSim per
+// kernel gets the same random actions, and after each tick every lane must match the scalar run's
+bool checkStepKernels(size_t envs, int ticks) {
+    std::vector<StepKernel> kernels = getSupportedStepKernels();  // Fastest first, so scalar comes last
+    std::vector<BatchSim> batches;
+    batches.reserve(kernels.size());
+    for (const StepKernel& kernel : kernels) {
+        batches.emplace_back(envs);
+        batches.back().setStepKernel(kernel);
+        batches.back().setMaxEpisodeTicks(200);
+    }
+    const BatchSim& scalar = batches.back();
+
+    Rng rng;
+    rng.seed(10);
+    std::vector<Direction> actions(envs);
+    // Compares one per-environment array across all lanes
+    auto same = [envs](const auto* a, const auto* b) { return std::equal(a, a + envs, b); };
+    for (int tick = 1; tick <= ticks; ++tick) {
+        for (auto& action : actions) action = static_cast<Direction>(rng.nextBelow(4));
+        for (auto& batch : batches) batch.stepAll(actions.data());
+        for (size_t k = 0; k + 1 < batches.size(); ++k) {
+            const BatchSim& batch = batches[k];
+            bool match = same(batch.getHeadX(), scalar.getHeadX()) && same(batch.getHeadY(), scalar.getHeadY()) &&
+                         same(batch.getFoodX(), scalar.getFoodX()) && same(batch.getFoodY(), scalar.getFoodY()) &&
+                         same(batch.getDirections(), scalar.getDirections()) && same(batch.getScores(), scalar.getScores()) &&
+                         same(batch.getAlive(), scalar.getAlive()) && same(batch.getResults(), scalar.getResults()) &&
+                         same(batch.getDone(), scalar.getDone()) && same(batch.getFinalScores(), scalar.getFinalScores()) &&
+                         same(batch.getEpisodeTicks(), scalar.getEpisodeTicks());
+            if (!match) {
+                std::fprintf(stderr, "snake_bench: %s kernel diverged from scalar on tick %d\n", kernels[k].name, tick);
+                return false;
+            }
+        }
+    }
+    for (size_t k = 0; k + 1 < batches.size(); ++k) {
+        report("batch.match", std::string(kernels[k].name) + " envs=" + std::to_string(envs), "ticks", ticks);
+    }
+    return true;
+}
+
+// Runs a server-side match of many randomly steering snakes and encodes every tick as the server
+// does; reports the cost per tick and the average TICK frame size sent to each client
+void benchMatch(int size, size_t snakes, uint32_t ticks) {
+    MatchSim match(size, size, snakes / 4);
+    match.seed(10);
+    for (size_t i = 0; i < snakes; ++i) match.addSnake();
+    Rng rng;
+    rng.seed(11);
+    MatchDelta delta;
+    std::string frame;
+    match.step(delta);  // Spawns every snake
+    delta.events.clear();
+
+    uint64_t bytes = 0;
+    auto start = Clock::now();
+    for (uint32_t t = 0; t < ticks; ++t) {
+        for (size_t id = 0; id < snakes; ++id) {
+            if (rng.nextBelow(8) == 0) match.setDirection(static_cast<uint16_t>(id), static_cast<Direction>(rng.nextBelow(4)));
+        }
+        match.step(delta);
+        frame.clear();
+        encodeTick(frame, delta);
+        bytes += frame.size();
+        delta.events.clear();
+    }
+    double seconds = secondsSince(start);
+    std::string parameter = std::to_string(snakes) + " on " + std::to_string(size) + "x" + std::to_string(size);
+    report("match.step", parameter, "us/op", seconds * 1e6 / ticks);
+    report("match.delta", parameter, "bytes", static_cast<double>(bytes) / ticks);
+}
+
+// Plays rounds as the game loop does: reset, recorder, autopilot or queued random turns, and on
+// game over the leaderboard refresh. The first round warms the buffers up; every later one has to
+// run without a heap allocation. Returns false if one allocated
+bool benchRoundAllocations(int rounds) {
+    if (!ALLOCATION_COUNTING) {
+        std::printf("# round allocations: not counted (built without SNAKE_COUNT_ALLOCS)\n");
+        return true;
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / "snake_bench_rounds.db").string();
+    std::filesystem::remove(path);
+    ScoreStore store(path);
+    for (int i = 0; i < 100; ++i) store.record("player" + std::to_string(i), 10 * i + 10);
+
+    SnakeSim sim;
+    sim.setObstacles(randomObstacles(sim.getWidth(), sim.getHeight(), 20, 12));
+    Autopilot autopilot;
+    ReplayRecorder recorder;
+    recorder.reserve(1 << 16, sim.getObstacles().size());
+    InputQueue queue;
+    std::vector<ScoreEntry> leaderboard;
+    Rng rng;
+    rng.seed(13);
+
+    uint64_t allocations = 0;
+    uint64_t ticks = 0;
+    for (int round = 0; round <= rounds; ++round) {
+        uint64_t before = allocationCount();
+        uint64_t seed = rng.next();
+        sim.seed(seed);
+        sim.reset();
+        recorder.begin(seed, sim);
+        autopilot.resize(sim.getWidth(), sim.getHeight());
+        autopilot.reset();
+        queue.clear();
+        bool steered = round % 2 == 0;
+
+        for (;;) {
+            Direction direction = sim.getDirection();
+            InputEvent input;
+            if (steered) {
+                direction = autopilot.choose(sim);
+            } else {
+                queue.push(static_cast<Direction>(rng.nextBelow(4)), 0.0, sim.getDirection());
+                if (queue.pop(input)) direction = input.direction;
+            }
+            recorder.record(sim.getTicks() + 1, direction);
+            StepResult result = sim.step(direction);
+            ++ticks;
+            if (result == StepResult::DIED || result == StepResult::CLEARED) break;
+        }
+        recorder.finish(sim);
+        store.top(10, leaderboard);
+        sink = store.getRank("player5") + leaderboard.size();
+        if (round > 0) allocations += allocationCount() - before;
+    }
+    std::filesystem::remove(path);
+
+    report("alloc.round", std::to_string(rounds) + " rounds", "allocs", static_cast<double>(allocations) / rounds);
+    report("alloc.round", std::to_string(rounds) + " rounds", "ticks", static_cast<double>(ticks));
+    return allocations == 0;
+}
+
+// Writes a score file of entries distinct players
+void writeScoreFile(const std::string& filename, size_t entries) {
+    std::vector<ScoreEntry> scores;
+    Rng rng;
+    rng.seed(4);
+    for (size_t i = 0; i < entries; ++i) {
+        scores.push_back({"player" + std::to_string(i), static_cast<int>(rng.nextBelow(10000))});
+    }
+    writeLeaderboard(scores, filename);
+}
+
+// Parse cost of a legacy text score file, as paid once when it is imported
+void benchLegacyImport(size_t entries, int reps) {
+    std::string filename = (std::filesystem::temp_directory_path() / "snake_bench_scores.txt").string();
+    writeScoreFile(filename, entries);
+
+    auto start = Clock::now();
+    for (int i = 0; i < reps; ++i) sink = readLeaderboard(filename).size();
+    report("legacy.import", "entries=" + std::to_string(entries), "us/op", secondsSince(start) * 1e6 / reps);
+
+    std::filesystem::remove(filename);
+}
+
+// Lazy load, record, rank and top-10 cost of the indexed store at a given size
+void benchScoreStore(size_t entries, int reps) {
+    std::string filename = (std::filesystem::temp_directory_path() / "snake_bench_scores.db").string();
+    std::string parameter = "entries=" + std::to_string(entries);
+    std::filesystem::remove(filename);
+    {
+        PersistenceWorker worker;
+        ScoreStore store(filename);
+        store.setWriter(&worker);
+        Rng rng;
+        rng.seed(5);
+        for (size_t i = 0; i < entries; ++i) store.record("player" + std::to_string(i), 1 + rng.nextBelow(100000));
+    }
+
+    auto start = Clock::now();
+    ScoreStore store(filename);
+    sink = store.size();
+    report("store.load", parameter, "ms", secondsSince(start) * 1e3);
+
+    std::vector<std::string> names;
+    for (int i = 0; i < reps; ++i) names.push_back("player" + std::to_string((i * 7919ull) % entries));
+
+    start = Clock::now();
+    uint64_t rankSum = 0;
+    for (const auto& name : names) rankSum += store.getRank(name);
+    sink = rankSum;
+    report("store.rank", parameter, "ns/op", secondsSince(start) * 1e9 / reps);
+
+    start = Clock::now();
+    for (int i = 0; i < reps; ++i) sink = store.top(10).size();
+    report("store.top10", parameter, "ns/op", secondsSince(start) * 1e9 / reps);
+
+    start = Clock::now();
+    for (int i = 0; i < reps; ++i) store.record(names[i], 200000 + i);
+    report("store.record", parameter, "ns/op", secondsSince(start) * 1e9 / reps);
+
+    std::filesystem::remove(filename);
+}
+
+} // namespace
+
+int main() {
+    std::printf("# snake_bench 1\n");
+    std::printf("# step kernel: %s\n", getStepKernel().name);
+    std::printf("%-20s %-18s %-8s %14s\n", "# benchmark", "parameter", "unit", "value");
+
+    benchStep(SnakeSim::DEFAULT_WIDTH, SnakeSim::DEFAULT_HEIGHT, 20000000);
+    benchStep(64, 64, 20000000);
+    benchStep(256, 256, 20000000);
+    // An odd lane count leaves a remainder for the vector kernels' scalar tail
+    if (!checkStepKernels(1021, 5000)) return 1;
+    benchBatchStep(1024, 20000);
+
+    for (size_t length : {3, 100, 300, 550}) benchFoodSpawn(length, 10000000);
+    for (size_t obstacles : {0, 100, 1000, 10000}) benchCollision(obstacles, 10000000);
+    benchLevelLoad(256, 50);
+    benchLevelLoad(4096, 3);
+    benchLevelSwitch(256, 1000);
+
+    benchAutopilot(SnakeSim::DEFAULT_WIDTH, SnakeSim::DEFAULT_HEIGHT, 1000000);
+    benchAutopilot(1024, 1024, 20000);
+
+    benchMatch(64, 16, 100000);
+    benchMatch(256, 256, 20000);
+
+    benchLegacyImport(1000, 200);
+    benchLegacyImport(100000, 5);
+
+    benchScoreStore(1000, 1000);
+    benchScoreStore(1000000, 1000);
+
+    if (!benchRoundAllocations(200)) {
+        std::fprintf(stderr, "snake_bench: rounds allocated on the heap after warm-up\n");
+        return 1;
+    }
+    return 0;
+}
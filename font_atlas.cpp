@@ -0,0 +1,181 @@
+/**
+ * @file font_atlas.cpp
+ * @brief Implementation of the multi-size font atlas.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "font_atlas.hpp"
+#include "persistence.hpp"
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+
+// Metrics file: magic, version, TTF modification time, the baked sizes, then
+// (value, offsetX, offsetY, advanceX, rec) per glyph, in host byte order since
+// the cache never leaves the machine that wrote it
+const char MAGIC[4] = {'S', 'N', 'K', 'F'};
+const uint32_t VERSION = 1;
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T take(const std::string& data, size_t& pos) {
+    T value;
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+// Constructor: Every size maps to nothing until load()
+FontAtlas::FontAtlas() : fonts(), texture() {}
+
+// Builds or restores the atlas and points one Font per size into it
+void FontAtlas::load(const std::string& ttfPath, const std::string& cachePath) {
+    unload();
+    long sourceTime = FileExists(ttfPath.c_str()) ? GetFileModTime(ttfPath.c_str()) : 0;
+
+    Image atlas = {};
+    bool cached = sourceTime != 0 && loadCache(cachePath, sourceTime, atlas);
+    if (!cached && (sourceTime == 0 || !bake(ttfPath, atlas))) {
+        if (atlas.data) UnloadImage(atlas);
+        recs.clear();
+        glyphs.clear();
+        fonts.fill(GetFontDefault());
+        return;
+    }
+
+    texture = LoadTextureFromImage(atlas);
+    SetTextureFilter(texture, TEXTURE_FILTER_POINT);  // Glyphs are drawn at their baked size
+    if (!cached) saveCache(cachePath, sourceTime, atlas);
+    UnloadImage(atlas);
+    bindFonts();
+}
+
+// Releases the texture; the Fonts only borrow it and the glyph arrays
+void FontAtlas::unload() {
+    if (texture.id != 0) UnloadTexture(texture);
+    texture = Texture2D();
+    recs.clear();
+    glyphs.clear();
+    fonts.fill(Font());
+}
+
+// Returns the font baked for a size, rounding up to the next baked size
+const Font& FontAtlas::get(float size) const {
+    for (size_t i = 0; i < SIZES.size(); ++i) {
+        if (SIZES[i] >= size) return fonts[i];
+    }
+    return fonts.back();
+}
+
+// Rasterizes the TTF at every size and packs all glyphs into one image
+bool FontAtlas::bake(const std::string& ttfPath, Image& atlas) {
+    std::ifstream file(ttfPath, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    glyphs.clear();
+    glyphs.reserve(SIZES.size() * GLYPH_COUNT);
+    for (int size : SIZES) {
+        GlyphInfo* sized = LoadFontData(data.data(), static_cast<int>(data.size()), size, nullptr, GLYPH_COUNT, FONT_DEFAULT);
+        if (!sized) {
+            for (auto& glyph : glyphs) UnloadImage(glyph.image);
+            glyphs.clear();
+            return false;
+        }
+        glyphs.insert(glyphs.end(), sized, sized + GLYPH_COUNT);
+        MemFree(sized);
+    }
+
+    // Rows are packed at the largest size's height, which fits every smaller glyph
+    Rectangle* packed = nullptr;
+    atlas = GenImageFontAtlas(glyphs.data(), &packed, static_cast<int>(glyphs.size()), SIZES.back(), PADDING, 0);
+    if (packed) {
+        recs.assign(packed, packed + glyphs.size());
+        MemFree(packed);
+    }
+
+    // Drawing only needs the atlas, so the per-glyph bitmaps go now
+    for (auto& glyph : glyphs) {
+        UnloadImage(glyph.image);
+        glyph.image = Image();
+    }
+    return atlas.data != nullptr && recs.size() == glyphs.size();
+}
+
+// Restores a cached atlas if it was baked from this TTF at the current sizes
+bool FontAtlas::loadCache(const std::string& cachePath, long sourceTime, Image& atlas) {
+    std::ifstream file(cachePath + ".bin", std::ios::binary);
+    if (!file.is_open()) return false;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const size_t glyphTotal = SIZES.size() * GLYPH_COUNT;
+    const size_t headerSize = sizeof(MAGIC) + sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t) + SIZES.size() * sizeof(int32_t);
+    const size_t glyphSize = 4 * sizeof(int32_t) + sizeof(Rectangle);
+    if (data.size() != headerSize + glyphTotal * glyphSize || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) return false;
+
+    size_t pos = sizeof(MAGIC);
+    if (take<uint32_t>(data, pos) != VERSION || take<int64_t>(data, pos) != sourceTime) return false;
+    if (take<uint32_t>(data, pos) != SIZES.size()) return false;
+    for (int size : SIZES) {
+        if (take<int32_t>(data, pos) != size) return false;
+    }
+
+    Image image = LoadImage((cachePath + ".png").c_str());
+    if (!image.data) return false;
+
+    glyphs.resize(glyphTotal);
+    recs.resize(glyphTotal);
+    for (size_t i = 0; i < glyphTotal; ++i) {
+        GlyphInfo& glyph = glyphs[i];
+        glyph.value = take<int32_t>(data, pos);
+        glyph.offsetX = take<int32_t>(data, pos);
+        glyph.offsetY = take<int32_t>(data, pos);
+        glyph.advanceX = take<int32_t>(data, pos);
+        glyph.image = Image();
+        recs[i] = take<Rectangle>(data, pos);
+    }
+    atlas = image;
+    return true;
+}
+
+// Writes the atlas as a PNG and the glyph metrics beside it; a failure only costs a rebake
+void FontAtlas::saveCache(const std::string& cachePath, long sourceTime, const Image& atlas) const {
+    if (!ExportImage(atlas, (cachePath + ".png").c_str())) return;
+
+    std::string bytes(MAGIC, sizeof(MAGIC));
+    put<uint32_t>(bytes, VERSION);
+    put<int64_t>(bytes, sourceTime);
+    put<uint32_t>(bytes, static_cast<uint32_t>(SIZES.size()));
+    for (int size : SIZES) put<int32_t>(bytes, size);
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        put<int32_t>(bytes, glyphs[i].value);
+        put<int32_t>(bytes, glyphs[i].offsetX);
+        put<int32_t>(bytes, glyphs[i].offsetY);
+        put<int32_t>(bytes, glyphs[i].advanceX);
+        put<Rectangle>(bytes, recs[i]);
+    }
+    writeFileAtomic(cachePath + ".bin", bytes);
+}
+
+// Points each size's Font at its slice of the shared glyph and rectangle arrays
+void FontAtlas::bindFonts() {
+    for (size_t i = 0; i < SIZES.size(); ++i) {
+        Font& font = fonts[i];
+        font.baseSize = SIZES[i];
+        font.glyphCount = GLYPH_COUNT;
+        font.glyphPadding = PADDING;
+        font.texture = texture;
+        font.recs = recs.data() + i * GLYPH_COUNT;
+        font.glyphs = glyphs.data() + i * GLYPH_COUNT;
+    }
+}
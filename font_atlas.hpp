@@ -0,0 +1,51 @@
+/**
+ * @file font_atlas.hpp
+ * @brief One texture holding the UI font rasterized at every size the UI uses.
+ * @details Text is drawn at a handful of fixed sizes. Instead of scaling one
+ * font for all of them, load() rasterizes the TTF once per size and packs
+ * every glyph into a single atlas texture; get() returns a Font whose base
+ * size equals the requested size, so glyphs are drawn 1:1 with point
+ * filtering. The packed atlas and its glyph metrics are cached next to the
+ * TTF and reused on later launches while the TTF is unchanged.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef FONT_ATLAS_HPP
+#define FONT_ATLAS_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include "raylib.h"
+
+class FontAtlas {
+public:
+    static constexpr std::array<int, 9> SIZES = { 12, 14, 16, 18, 20, 22, 28, 32, 40 };
+    static constexpr int FIRST_CHAR = 32;  // Printable ASCII
+    static constexpr int GLYPH_COUNT = 95;
+    static constexpr int PADDING = 2;
+
+    FontAtlas();
+
+    // Uses the cache when it matches the TTF, otherwise rasterizes and rewrites it
+    // Falls back to raylib's default font when the TTF cannot be read
+    void load(const std::string& ttfPath, const std::string& cachePath);
+    void unload();
+
+    const Font& get(float size) const;  // Exact size when baked, else the nearest larger one
+    bool isBaked() const { return texture.id != 0; }
+
+private:
+    std::array<Font, SIZES.size()> fonts;
+    Texture2D texture;
+    std::vector<Rectangle> recs;     // GLYPH_COUNT entries per size, in SIZES order
+    std::vector<GlyphInfo> glyphs;
+
+    bool bake(const std::string& ttfPath, Image& atlas);
+    bool loadCache(const std::string& cachePath, long sourceTime, Image& atlas);
+    void saveCache(const std::string& cachePath, long sourceTime, const Image& atlas) const;
+    void bindFonts();
+};
+
+#endif // FONT_ATLAS_HPP
@@ -0,0 +1,57 @@
+/**
+ * @file free_cell_set.hpp
+ * @brief Indexed set of empty board cells with constant-time updates.
+ * @details Free cells are kept densely packed in an array, with a reverse
+ * map from cell index to slot. Removal swaps the last element into the
+ * vacated slot, so insert, erase and picking a uniformly random free cell
+ * are all O(1) and never allocate after construction.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef FREE_CELL_SET_HPP
+#define FREE_CELL_SET_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class FreeCellSet {
+public:
+    explicit FreeCellSet(size_t cellCount)
+        : cells(cellCount), slots(cellCount, NONE), count(0) {}
+
+    bool contains(uint32_t cell) const { return slots[cell] != NONE; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    uint32_t at(size_t slot) const { return cells[slot]; }
+
+    void insert(uint32_t cell) {
+        if (slots[cell] != NONE) return;
+        cells[count] = cell;
+        slots[cell] = static_cast<uint32_t>(count++);
+    }
+
+    void erase(uint32_t cell) {
+        uint32_t slot = slots[cell];
+        if (slot == NONE) return;
+        uint32_t last = cells[--count];
+        cells[slot] = last;
+        slots[last] = slot;
+        slots[cell] = NONE;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < count; ++i) slots[cells[i]] = NONE;
+        count = 0;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    std::vector<uint32_t> cells;
+    std::vector<uint32_t> slots;
+    size_t count;
+};
+
+#endif // FREE_CELL_SET_HPP
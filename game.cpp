@@ -6,74 +6,253 @@
  */
 
 #include "game.hpp"
+#include "rlgl.h"
 #include <fstream>
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
+#include <random>
 #include <sstream>
 #include <iomanip>
-#include <map>
 #include <cmath>
+#include <stdexcept>
+#include <cstdio>
+
+namespace {
+
+// Fragment shader for the body layer: decodes the tick stamped into a cell and
+// applies the same length-relative fade as the full redraw
+const char* BODY_FRAGMENT_SHADER = R"(
+#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform float currentTick;
+uniform float snakeLength;
+uniform vec4 bodyColor;
+out vec4 finalColor;
+
+void main() {
+    vec4 stamp = texture(texture0, fragTexCoord);
+    if (stamp.a == 0.0) discard;
+    vec3 bytes = floor(stamp.rgb * 255.0 + 0.5);
+    float tick = bytes.r * 65536.0 + bytes.g * 256.0 + bytes.b;
+    float index = mod(currentTick - tick + 16777216.0, 16777216.0);
+    float fade = 1.0 - index / snakeLength;
+    finalColor = vec4(bodyColor.rgb, floor(255.0 * fade * 0.8 + 51.0) / 255.0);
+}
+)";
+
+constexpr uint32_t TICK_STAMP_MASK = 0xFFFFFF;  // Ticks are stored in the 24 colour bits of a texel
+
+} // namespace
 
 // Constructor: Initializes the game, loads resources and settings
-Game::Game(const std::string& playerName) 
-    : currentState(GameState::MENU), score(0), overallHighestScore(0), personalBestScore(0),
+Game::Game(const std::string& playerName, const GameConfig& config) 
+    : currentState(GameState::MENU), nextDirection(Direction::UP), previousHead({0, 0}), previousTail({0, 0}),
+      overallHighestScore(0), personalBestScore(0),
       moveTimer(0.0f), moveInterval(0.15f), animationTimer(0.0f),
-      playerName(playerName), selectedMenuItem(0), gameRunning(true), showGrid(true) {
+      playerName(playerName), selectedMenuItem(0),
+      playerText("Player: " + playerName), welcomeText("Welcome, " + playerName + "!"), welcomeSize({ 0.0f, 0.0f }),
+      scoreLabel("Score: ", 20), personalBestLabel("Your Best: ", 16), overallBestLabel("Best Overall: ", 16),
+      speedLabel("Speed Level: ", 16), finalScoreLabel("Final Score: ", 20),
+      menuHighestLabel("Highest Score: ", 14), menuPersonalLabel("Your Best: ", 14), playersLabel("Players: ", 16), roundSeed(0),
+      recordPath(config.recordPath), replayPlayer(playback), replayMode(false), gameRunning(true), redrawRequested(true), windowFocused(true), showGrid(true), incrementalRender(false),
+      boardWidth(SnakeSim::DEFAULT_WIDTH), boardHeight(SnakeSim::DEFAULT_HEIGHT), levelIndex(-1), activeLevel(nullptr),
+      viewWidth(0), viewHeight(0), screenWidth(0), screenHeight(0), camera(),
+      scoreStore("scores.db", { "scores.txt", "user_scores.txt" }), profilePath(config.profilePath), showProfiler(false),
+      staticLayer(), staticLayerVersion(0), staticLayerGrid(false),
+      bodyLayer(), bodyShader(), bodyTickLoc(-1), bodyLengthLoc(-1), bodyLayerTick(0), bodyLayerStale(true),
+      startupLoaded(false), startupFinished(false),
+      targetFps(config.targetFps), inputPollRate(config.vsync || config.targetFps <= 0 ? 0 : config.inputRate), lastUpdateTime(0.0),
+      autopilotMode(false), restartTimer(0.0f), networkMode(false), turnSent(false), matchLayoutVersion(0) {
     
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Snake Game - Modern Edition");
-    SetTargetFPS(60);
-    
-    font = LoadFont("resources/roboto.ttf");
-    if (font.texture.id == 0) {
-        font = GetFontDefault();
+    // Board size comes from settings.txt unless overridden on the command line
+    loadSettings();
+    sim.resize(config.gridWidth > 0 ? config.gridWidth : boardWidth,
+               config.gridHeight > 0 ? config.gridHeight : boardHeight);
+
+    // Scores and levels are read by startupLoader; the first round needs them, the menu does not
+    int levelWidth = sim.getWidth();
+    int levelHeight = sim.getHeight();
+
+    // A replay brings its own board and obstacle layout
+    if (!config.replayPath.empty()) {
+        if (!loadReplay(config.replayPath, playback)) {
+            throw std::runtime_error("Could not load replay: " + config.replayPath);
+        }
+        replayMode = true;
+        sim.resize(playback.width, playback.height);
+        sim.setObstacles(playback.obstacles);
+    }
+
+    // A networked game joins before the window opens; the board arrives with the server's welcome
+    if (!config.connectAddress.empty()) {
+        std::string error;
+        if (!netClient.connect(config.connectAddress, playerName, error)) {
+            throw std::runtime_error("Could not connect to " + config.connectAddress + ": " + error);
+        }
+        networkMode = true;
+        inputPollRate = 0;
     }
+    configureViewport();
+
+    if (config.vsync) SetConfigFlags(FLAG_VSYNC_HINT);
+    InitWindow(screenWidth, screenHeight, "Snake Game - Modern Edition");
+    SetTargetFPS(config.targetFps);  // Event waiting starts once the startup data is in
+
+    // A failed compile leaves raylib's default shader; updateBodyLayer then keeps full redraws
+    bodyShader = LoadShaderFromMemory(nullptr, BODY_FRAGMENT_SHADER);
+    bodyTickLoc = GetShaderLocation(bodyShader, "currentTick");
+    bodyLengthLoc = GetShaderLocation(bodyShader, "snakeLength");
+    float bodyColor[4] = { colors.snakeBody.r / 255.0f, colors.snakeBody.g / 255.0f, colors.snakeBody.b / 255.0f, 1.0f };
+    SetShaderValue(bodyShader, GetShaderLocation(bodyShader, "bodyColor"), bodyColor, SHADER_UNIFORM_VEC4);
+    vacatedCells.reserve(MAX_TICKS_PER_FRAME);
     
-    srand(time(nullptr));
+    // Every UI size is baked into one atlas, cached so later launches skip rasterizing
+    fonts.load("resources/Roboto-Regular.ttf", "resources/font_atlas");
+    welcomeSize = MeasureTextEx(fonts.get(18), welcomeText.c_str(), 18, 1);
     
-    loadSettings();
-    loadHighestScores();
-    loadLeaderboard();
-    loadObstacles("obstacles.txt");
+    sessionRng.seed(config.fixedSeed ? config.seed : std::random_device{}());
+    
+    scoreStore.setWriter(&persistence);
+    recorder.reserve(REPLAY_EVENT_RESERVE, sim.getObstacles().size());
     reset();
+    startupLoader = std::thread(&Game::loadStartupData, this, config.levelPath, config.levelPackPath, levelWidth, levelHeight);
 }
 
 // Destructor: Saves session data and releases resources
 Game::~Game() {
-    saveSessionBestScore();
+    if (startupLoader.joinable()) startupLoader.join();
     saveSettings();
-    UnloadFont(font);
+    if (!profilePath.empty()) profiler.exportTo(profilePath);
+    if (staticLayer.id != 0) UnloadRenderTexture(staticLayer);
+    if (bodyLayer.id != 0) UnloadRenderTexture(bodyLayer);
+    if (bodyShader.id != rlGetShaderIdDefault()) UnloadShader(bodyShader);
+    fonts.unload();
     CloseWindow();
 }
 
 // Main game loop
+// Idle screens block on input events and skip frames in which nothing changed; a network match
+// keeps running behind every screen, so then every frame is drawn
 void Game::run() {
+    int activeFrames = 0;  // Frames since the last idle one
     while (!WindowShouldClose() && gameRunning) {
-        float deltaTime = GetFrameTime();
+        // Time spent blocked on an idle screen leaks into the next two frame times; it is not game time
+        double frameStart = GetTime();
+        float deltaTime = activeFrames < 2 ? 0.0f : static_cast<float>(frameStart - lastUpdateTime);
+        lastUpdateTime = frameStart;
         
+        profiler.beginFrame();
+        // Until the startup data arrives, idle screens keep drawing so the placeholders get replaced
+        if (!finishStartup(false)) redrawRequested = true;
         handleInput();
         
-        if (currentState == GameState::PLAYING) {
+        profiler.mark(ProfilePhase::UPDATE);
+        if (networkMode) {
+            updateMatch();
+        } else if (currentState == GameState::PLAYING) {
             update(deltaTime);
+        } else if (currentState == GameState::GAME_OVER && autopilotMode) {
+            restartTimer += deltaTime;
+            if (restartTimer >= AUTOPILOT_RESTART_DELAY) startRound(true);
         }
         
         updateAnimations(deltaTime);
+
+        if (IsWindowFocused() != windowFocused) {
+            windowFocused = !windowFocused;
+            redrawRequested = true;
+        }
+        if (networkMode || !isIdleState(currentState)) {
+            activeFrames = std::min(activeFrames + 1, 2);
+        } else {
+            activeFrames = 0;
+            while (GetKeyPressed() != 0) redrawRequested = true;
+            if (!redrawRequested) {
+                PollInputEvents();  // Blocks until the next event while event waiting is on
+                continue;
+            }
+            redrawRequested = false;
+        }
+        profiler.mark(ProfilePhase::DRAW);
         draw();
+        if (inputPollRate > 0 && currentState == GameState::PLAYING) pollInputUntil(frameStart + 1.0 / targetFps);
+        profiler.endFrame();
+    }
+}
+
+// High-rate input: sleeps out the rest of a playing frame in short slices, reading keys and
+// running due ticks after each, so a turn waits for one slice instead of a whole frame
+void Game::pollInputUntil(double frameEnd) {
+    double slice = 1.0 / inputPollRate;
+    double now = GetTime();
+    while (currentState == GameState::PLAYING && now < frameEnd) {
+        WaitTime(std::min(slice, frameEnd - now));
+        PollInputEvents();
+        handleInput();
+        now = GetTime();
+        if (currentState == GameState::PLAYING) update(static_cast<float>(now - lastUpdateTime));
+        lastUpdateTime = now;
+    }
+}
+
+// Measures frames per second of the play field at several board sizes, with and without
+// the incremental body layer; the snake moves randomly and restarts silently on death
+void Game::runRenderBenchmark() {
+    static const int sizes[][2] = { { 30, 20 }, { 128, 128 }, { 512, 512 }, { 2048, 2048 } };
+    const int warmupFrames = 60;
+    const int measuredFrames = 600;
+
+    SetTargetFPS(0);
+    finishStartup(true);
+    currentState = GameState::PLAYING;
+    levelIndex = -1;  // Keeps applyLevel from replacing the generated layouts
+    activeLevel = &baseLevel;
+    DisableEventWaiting();
+    std::printf("%-20s %-18s %-8s %14s\n", "# benchmark", "parameter", "unit", "value");
+
+    for (const auto& size : sizes) {
+        sim.resize(size[0], size[1]);
+        std::vector<Position> layout;
+        for (int i = 0; i < size[0] * size[1] / 48; ++i) {
+            layout.push_back({ static_cast<int16_t>(sessionRng.nextBelow(size[0])), static_cast<int16_t>(sessionRng.nextBelow(size[1])) });
+        }
+        sim.setObstacles(layout);
+        configureViewport();
+        SetWindowSize(screenWidth, screenHeight);
+
+        for (bool incremental : { false, true }) {
+            incrementalRender = incremental;
+            reset();
+            double start = 0.0;
+            for (int frame = 0; frame < warmupFrames + measuredFrames; ++frame) {
+                if (frame == warmupFrames) start = GetTime();
+                previousHead = sim.getSnake().front();
+                previousTail = sim.getSnake().back();
+                StepResult result = sim.step(static_cast<Direction>(sessionRng.nextBelow(4)));
+                if (result == StepResult::DIED || result == StepResult::CLEARED) reset();
+                moveTimer = calculateSpeed() * 0.5f;
+                draw();
+            }
+            char parameter[32];
+            std::snprintf(parameter, sizeof(parameter), "%dx%d%s", size[0], size[1], incremental ? " incr" : "");
+            std::printf("%-20s %-18s %-8s %14.2f\n", "render.frame", parameter, "frames/s", measuredFrames / (GetTime() - start));
+        }
     }
 }
 
 // Handles input based on current game state
 void Game::handleInput() {
+    if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
+
     switch (currentState) {
         case GameState::MENU:         handleMenuInput(); break;
         case GameState::PLAYING:      handleGameInput(); break;
         case GameState::LEADERBOARD:  handleLeaderboardInput(); break;
         case GameState::SETTINGS:     handleSettingsInput(); break;
         case GameState::GAME_OVER:
-            if (IsKeyPressed(KEY_R)) {
-                reset();
-                changeState(GameState::PLAYING);
-            }
+            // A restart always hands control back to the player, even after an autopilot round
+            if (IsKeyPressed(KEY_R)) startRound(false);
             if (IsKeyPressed(KEY_Q) || IsKeyPressed(KEY_ESCAPE)) changeState(GameState::MENU);
             if (IsKeyPressed(KEY_L)) changeState(GameState::LEADERBOARD);
             break;
@@ -87,24 +266,26 @@ void Game::handleInput() {
 // Handles input in the main menu
 void Game::handleMenuInput() {
     if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
-        selectedMenuItem = (selectedMenuItem + 1) % 4;
+        selectedMenuItem = (selectedMenuItem + 1) % 5;
     }
     if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
-        selectedMenuItem = (selectedMenuItem - 1 + 4) % 4;
+        selectedMenuItem = (selectedMenuItem - 1 + 5) % 5;
     }
     if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
         switch (selectedMenuItem) {
-            case 0: reset(); changeState(GameState::PLAYING); break;
-            case 1: changeState(GameState::LEADERBOARD); break;
-            case 2: changeState(GameState::SETTINGS); break;
-            case 3: gameRunning = false; break;
+            case 0: startRound(false); break;
+            case 1: startRound(true); break;
+            case 2: changeState(GameState::LEADERBOARD); break;
+            case 3: changeState(GameState::SETTINGS); break;
+            case 4: gameRunning = false; break;
         }
     }
 }
 
 // Handles input during gameplay
 void Game::handleGameInput() {
-    if (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_SPACE)) {
+    // A network match does not wait for anyone, so it cannot be paused
+    if (!networkMode && (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_SPACE))) {
         changeState(GameState::PAUSED);
         return;
     }
@@ -112,11 +293,23 @@ void Game::handleGameInput() {
         changeState(GameState::MENU);
         return;
     }
-    
-    if ((IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP)) && currentDirection != Direction::DOWN) nextDirection = Direction::UP;
-    if ((IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN)) && currentDirection != Direction::UP) nextDirection = Direction::DOWN;
-    if ((IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT)) && currentDirection != Direction::RIGHT) nextDirection = Direction::LEFT;
-    if ((IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT)) && currentDirection != Direction::LEFT) nextDirection = Direction::RIGHT;
+    if (replayMode || autopilotMode) return;
+
+    // Keys come in press order, so two turns within one frame are queued in the order they were made
+    double now = GetTime();
+    const MatchSnake* own = networkMode ? getOwnSnake() : nullptr;
+    Direction heading = networkMode ? (own ? own->direction : Direction::UP) : sim.getDirection();
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        Direction direction;
+        switch (key) {
+            case KEY_W: case KEY_UP:    direction = Direction::UP; break;
+            case KEY_S: case KEY_DOWN:  direction = Direction::DOWN; break;
+            case KEY_A: case KEY_LEFT:  direction = Direction::LEFT; break;
+            case KEY_D: case KEY_RIGHT: direction = Direction::RIGHT; break;
+            default: continue;
+        }
+        inputQueue.push(direction, now, heading);
+    }
 }
 
 // Handles input in the leaderboard screen
@@ -128,8 +321,26 @@ void Game::handleLeaderboardInput() {
 
 // Handles input in the settings screen
 void Game::handleSettingsInput() {
+    if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
+        selectedMenuItem = (selectedMenuItem + 1) % 3;
+    }
+    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
+        selectedMenuItem = (selectedMenuItem - 1 + 3) % 3;
+    }
     if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
-        showGrid = !showGrid;
+        if (selectedMenuItem == 0) showGrid = !showGrid;
+        else if (selectedMenuItem == 1) incrementalRender = !incrementalRender;
+    }
+
+    // Levels cycle through the --level map (-1) and every pack entry
+    if (selectedMenuItem == 2 && startupFinished) {
+        int choices = static_cast<int>(levelPack.size()) + 1;
+        if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D) || IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
+            selectLevel((levelIndex + 2) % choices - 1);
+        }
+        if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) {
+            selectLevel((levelIndex + choices) % choices - 1);
+        }
     }
     
     if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_Q)) {
@@ -138,34 +349,72 @@ void Game::handleSettingsInput() {
     }
 }
 
-// Updates game logic (snake movement, food, collision)
+// Updates game logic with a fixed timestep: runs as many ticks as the elapsed time covers
 void Game::update(float deltaTime) {
     moveTimer += deltaTime;
-    float currentSpeed = calculateSpeed();
     
-    if (moveTimer >= currentSpeed) {
-        moveTimer = 0.0f;
-        currentDirection = nextDirection;
-        moveSnake();
-        
-        if (checkCollision()) {
-            saveToLeaderboard();
-            savePersonalBest();
-            changeState(GameState::GAME_OVER);
+    int ticks = 0;
+    while (moveTimer >= calculateSpeed()) {
+        moveTimer -= calculateSpeed();
+        if (!stepSimulation()) {
+            moveTimer = 0.0f;
             return;
         }
-        
-        if (snake.front() == food) {
-            score += 10;
-            generateFood();
-        } else {
-            snake.pop_back();
+        // After a long stall drop the backlog instead of fast-forwarding through it
+        if (++ticks == MAX_TICKS_PER_FRAME) {
+            moveTimer = std::min(moveTimer, calculateSpeed());
+            break;
+        }
+    }
+}
+
+// Runs one simulation tick; returns false when the round ended
+bool Game::stepSimulation() {
+    uint32_t tick = sim.getTicks() + 1;
+    InputEvent input;
+    if (replayMode) {
+        nextDirection = replayPlayer.directionFor(tick);
+    } else if (autopilotMode) {
+        nextDirection = autopilot.choose(sim);
+    } else if (inputQueue.pop(input)) {
+        nextDirection = input.direction;
+        inputLatency.add(GetTime() - input.time);
+    }
+    recorder.record(tick, nextDirection);
+
+    previousHead = sim.getSnake().front();
+    previousTail = sim.getSnake().back();
+    StepResult result = sim.step(nextDirection);
+    profiler.countTick();
+    // Polling input between slices runs several updates per frame; past the reserved room a full rewrite is cheaper
+    if (bodyLayer.id != 0 && !bodyLayerStale) {
+        if (vacatedCells.size() < vacatedCells.capacity()) vacatedCells.push_back(previousTail);
+        else bodyLayerStale = true;
+    }
+    if (result == StepResult::DIED || result == StepResult::CLEARED) {
+        recorder.finish(sim);
+        if (!recordPath.empty()) saveReplay(recorder.getReplay(), recordPath);
+        // Autopilot rounds are demos, not the player's scores
+        if (!replayMode && !autopilotMode) {
+            saveScore();
         }
+        changeState(GameState::GAME_OVER);
+        return false;
     }
+    return true;
+}
+
+// Returns how far the current frame lies between the previous tick and the next one
+float Game::getTickAlpha() const {
+    if (currentState != GameState::PLAYING && currentState != GameState::PAUSED) return 1.0f;
+    return std::max(0.0f, std::min(1.0f, moveTimer / calculateSpeed()));
 }
 
 // Draws the current frame based on game state
 void Game::draw() {
+    updateStaticLayer();
+    updateBodyLayer();
+
     BeginDrawing();
     ClearBackground(colors.background);
     
@@ -178,192 +427,498 @@ void Game::draw() {
         case GameState::SETTINGS:     drawSettings(); break;
     }
     
+    profiler.mark(ProfilePhase::PRESENT);
     EndDrawing();
 }
 
-// Draws the game field, snake, food, and obstacles
+// Draws the game field, snake, food, and obstacles through the viewport camera
+// Cells and glows are queued in fieldBatch and submitted together at the end
 void Game::drawGameField() {
-    if (showGrid) drawGrid();
-    
-    for (const auto& obs : obstacles) {
-        DrawRectangle(obs.x * CELL_SIZE, obs.y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, colors.obstacle);
-        drawGlowEffect(obs, colors.obstacle, 0.3f);
+    updateCamera();
+    BeginScissorMode(0, 0, viewWidth * CELL_SIZE, viewHeight * CELL_SIZE);
+    BeginMode2D(camera);
+
+    if (staticLayer.id != 0) {
+        Rectangle source = { 0, 0, (float)staticLayer.texture.width, -(float)staticLayer.texture.height };
+        DrawTextureRec(staticLayer.texture, source, { 0, 0 }, WHITE);
+    } else {
+        int firstX = static_cast<int>(camera.target.x) / CELL_SIZE;
+        int firstY = static_cast<int>(camera.target.y) / CELL_SIZE;
+        drawStaticLayer(firstX, firstY, std::min(sim.getWidth(), firstX + viewWidth + 1),
+                        std::min(sim.getHeight(), firstY + viewHeight + 1));
+    }
+
+    if (networkMode) drawMatch();
+    else drawSnake();
+
+    fieldBatch.flush();
+    EndMode2D();
+    EndScissorMode();
+}
+
+// Draws the local round's snake and food, head and tail interpolated between ticks
+void Game::drawSnake() {
+    const auto& snake = sim.getSnake();
+    float alpha = getTickAlpha();
+
+    // With the body layer only the head and tail go through the batch
+    bool bodyCached = bodyLayer.id != 0;
+    if (bodyCached) {
+        float tick = static_cast<float>(sim.getTicks() & TICK_STAMP_MASK);
+        float length = static_cast<float>(snake.size());
+        SetShaderValue(bodyShader, bodyTickLoc, &tick, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(bodyShader, bodyLengthLoc, &length, SHADER_UNIFORM_FLOAT);
+        fieldBatch.flush();
+        BeginShaderMode(bodyShader);
+        Rectangle source = { 0, 0, (float)bodyLayer.texture.width, -(float)bodyLayer.texture.height };
+        DrawTextureRec(bodyLayer.texture, source, { 0, 0 }, WHITE);
+        EndShaderMode();
     }
     
     for (size_t i = 0; i < snake.size(); ++i) {
-        Color segmentColor = (i == 0) ? colors.snakeHead : colors.snakeBody;
-        if (i > 0) {
-            float fade = 1.0f - (static_cast<float>(i) / snake.size());
-            segmentColor.a = static_cast<unsigned char>(255 * fade * 0.8f + 51);
+        if (bodyCached && i != 0 && i != snake.size() - 1) continue;
+        if (!isCellVisible(snake[i])) continue;
+        // Head and tail slide between ticks; the body stays on its cells
+        Vector2 cell = { (float)snake[i].x, (float)snake[i].y };
+        if (i == 0 || i == snake.size() - 1) {
+            Position from = (i == 0) ? previousHead : previousTail;
+            cell.x = from.x + (cell.x - from.x) * alpha;
+            cell.y = from.y + (cell.y - from.y) * alpha;
         }
-        DrawRectangle(snake[i].x * CELL_SIZE, snake[i].y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, segmentColor);
-        if (i == 0) drawGlowEffect(snake[i], colors.snakeHead, 0.5f);
+        drawSegment(cell, i, snake.size(), colors.snakeHead, colors.snakeBody);
     }
     
+    if (sim.hasFood()) drawFood(sim.getFood());
+}
+
+// Draws every snake and food of the network match; the player's own snake keeps the usual colours
+// Positions come straight from the last tick received, without interpolation
+void Game::drawMatch() {
+    const auto& snakes = match.getSnakes();
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        const auto& body = snakes[id].body;
+        bool own = netClient.hasJoined() && id == netClient.getSnakeId();
+        for (size_t i = 0; i < body.size(); ++i) {
+            if (!isCellVisible(body[i])) continue;
+            drawSegment({ (float)body[i].x, (float)body[i].y }, i, body.size(),
+                        own ? colors.snakeHead : colors.accent, own ? colors.snakeBody : colors.accent);
+        }
+    }
+    for (Position food : match.getFoods()) {
+        if (food.x >= 0 && isCellVisible(food)) drawFood(food);
+    }
+}
+
+// Queues one snake segment; the body fades towards the tail and the head glows
+void Game::drawSegment(Vector2 cell, size_t index, size_t length, Color headColor, Color bodyColor) {
+    Color segmentColor = (index == 0) ? headColor : bodyColor;
+    if (index > 0) {
+        float fade = 1.0f - (static_cast<float>(index) / length);
+        segmentColor.a = static_cast<unsigned char>(255 * fade * 0.8f + 51);
+    }
+    fieldBatch.addRect(cell.x * CELL_SIZE, cell.y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, segmentColor);
+    if (index == 0) drawGlowEffect(cell, headColor, 0.5f);
+}
+
+// Queues a pulsing food with its glow
+void Game::drawFood(Position food) {
     float pulse = sin(animationTimer * 8.0f) * 0.3f + 0.7f;
     Color pulsedFood = colors.food;
     pulsedFood.a = static_cast<unsigned char>(255 * pulse);
     
-    DrawCircle(food.x * CELL_SIZE + CELL_SIZE/2, food.y * CELL_SIZE + CELL_SIZE/2, (CELL_SIZE/2 - 2) * pulse, pulsedFood);
-    drawGlowEffect(food, colors.food, pulse * 0.6f);
+    fieldBatch.addCircle(food.x * CELL_SIZE + CELL_SIZE/2, food.y * CELL_SIZE + CELL_SIZE/2, (CELL_SIZE/2 - 2) * pulse, pulsedFood);
+    drawGlowEffect({ (float)food.x, (float)food.y }, colors.food, pulse * 0.6f);
 }
 
-// Draws the grid overlay
-void Game::drawGrid() {
-    for (int x = 0; x <= GRID_WIDTH; ++x) {
-        DrawLine(x * CELL_SIZE, 0, x * CELL_SIZE, GRID_HEIGHT * CELL_SIZE, colors.grid);
+// Draws the grid, obstacles and glows that lie within a range of cells
+void Game::drawStaticLayer(int firstX, int firstY, int lastX, int lastY) {
+    if (showGrid) drawGrid(firstX, firstY, lastX, lastY);
+
+    // The match keeps walls on the start column that sim drops, so network play draws exactly what the server collides with
+    const std::vector<Position>& obstacles = networkMode ? match.getObstacles() : sim.getObstacles();
+    for (const auto& obs : obstacles) {
+        if (obs.x < firstX - 1 || obs.x > lastX || obs.y < firstY - 1 || obs.y > lastY) continue;
+        fieldBatch.addRect(obs.x * CELL_SIZE, obs.y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, colors.obstacle);
+        drawGlowEffect({ (float)obs.x, (float)obs.y }, colors.obstacle, 0.3f);
+    }
+}
+
+// Renders the background into a texture when the grid setting, obstacles or board size changed
+// Boards too large for one texture skip the cache and draw their visible part every frame
+void Game::updateStaticLayer() {
+    int width = sim.getWidth() * CELL_SIZE;
+    int height = sim.getHeight() * CELL_SIZE;
+    if (width > MAX_STATIC_LAYER_SIZE || height > MAX_STATIC_LAYER_SIZE) {
+        if (staticLayer.id != 0) UnloadRenderTexture(staticLayer);
+        staticLayer = RenderTexture2D();
+        return;
     }
-    for (int y = 0; y <= GRID_HEIGHT; ++y) {
-        DrawLine(0, y * CELL_SIZE, GRID_WIDTH * CELL_SIZE, y * CELL_SIZE, colors.grid);
+
+    bool sizeChanged = staticLayer.texture.width != width || staticLayer.texture.height != height;
+    if (staticLayer.id != 0 && !sizeChanged &&
+        staticLayerVersion == sim.getLayoutVersion() && staticLayerGrid == showGrid) return;
+
+    if (staticLayer.id == 0 || sizeChanged) {
+        if (staticLayer.id != 0) UnloadRenderTexture(staticLayer);
+        staticLayer = LoadRenderTexture(width, height);
+    }
+
+    // The layer sits at the bottom, so it is opaque and glows blend exactly as on screen
+    BeginTextureMode(staticLayer);
+    ClearBackground(colors.background);
+    drawStaticLayer(0, 0, sim.getWidth(), sim.getHeight());
+    fieldBatch.flush();
+    EndTextureMode();
+
+    staticLayerVersion = sim.getLayoutVersion();
+    staticLayerGrid = showGrid;
+}
+
+// Brings the body texture up to date with the simulation
+// Normally only cells touched since the last sync are rewritten: dropped tails are cleared and the
+// cells the head left behind are stamped with their tick; the head and tail themselves stay out of
+// the texture because they are drawn interpolated every frame
+void Game::updateBodyLayer() {
+    int width = sim.getWidth() * CELL_SIZE;
+    int height = sim.getHeight() * CELL_SIZE;
+    bool usable = incrementalRender && !networkMode && bodyShader.id != rlGetShaderIdDefault() &&
+                  width <= MAX_STATIC_LAYER_SIZE && height <= MAX_STATIC_LAYER_SIZE;
+    if (!usable) {
+        if (bodyLayer.id != 0) UnloadRenderTexture(bodyLayer);
+        bodyLayer = RenderTexture2D();
+        vacatedCells.clear();
+        return;
+    }
+
+    if (bodyLayer.id == 0 || bodyLayer.texture.width != width || bodyLayer.texture.height != height) {
+        if (bodyLayer.id != 0) UnloadRenderTexture(bodyLayer);
+        bodyLayer = LoadRenderTexture(width, height);
+        bodyLayerStale = true;
+    }
+
+    const auto& snake = sim.getSnake();
+    uint32_t tick = sim.getTicks();
+    if (!bodyLayerStale && tick == bodyLayerTick) return;
+
+    // Writes replace texels outright so stamps stay exact and cleared cells get zero alpha
+    BeginTextureMode(bodyLayer);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+
+    size_t stampEnd = snake.size() - 1;
+    uint32_t advanced = tick - bodyLayerTick;
+    if (bodyLayerStale || advanced >= stampEnd) {
+        ClearBackground(BLANK);
+    } else {
+        for (Position cell : vacatedCells) {
+            fieldBatch.addRect(cell.x * CELL_SIZE, cell.y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, BLANK);
+        }
+        fieldBatch.addRect(snake.back().x * CELL_SIZE, snake.back().y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, BLANK);
+        stampEnd = advanced + 1;
+    }
+
+    // Segment i was the head i ticks ago
+    for (size_t i = 1; i < stampEnd; ++i) {
+        uint32_t stamp = (tick - static_cast<uint32_t>(i)) & TICK_STAMP_MASK;
+        Color texel = { (unsigned char)(stamp >> 16), (unsigned char)(stamp >> 8), (unsigned char)stamp, 255 };
+        fieldBatch.addRect(snake[i].x * CELL_SIZE, snake[i].y * CELL_SIZE, CELL_SIZE - 2, CELL_SIZE - 2, texel);
+    }
+    fieldBatch.flush();
+
+    EndBlendMode();
+    EndTextureMode();
+
+    vacatedCells.clear();
+    bodyLayerTick = tick;
+    bodyLayerStale = false;
+}
+
+// Draws the grid lines bounding a range of cells
+void Game::drawGrid(int firstX, int firstY, int lastX, int lastY) {
+    for (int x = firstX; x <= lastX; ++x) {
+        DrawLine(x * CELL_SIZE, firstY * CELL_SIZE, x * CELL_SIZE, lastY * CELL_SIZE, colors.grid);
+    }
+    for (int y = firstY; y <= lastY; ++y) {
+        DrawLine(firstX * CELL_SIZE, y * CELL_SIZE, lastX * CELL_SIZE, y * CELL_SIZE, colors.grid);
+    }
+}
+
+// Sizes the window to the board, switching to a scrolling viewport for large boards
+void Game::configureViewport() {
+    viewWidth = std::min(sim.getWidth(), MAX_VIEW_WIDTH);
+    viewHeight = std::min(sim.getHeight(), MAX_VIEW_HEIGHT);
+    screenWidth = std::max(MIN_SCREEN_WIDTH, viewWidth * CELL_SIZE + PANEL_WIDTH);
+    screenHeight = std::max(MIN_SCREEN_HEIGHT, viewHeight * CELL_SIZE + FOOTER_HEIGHT);
+    camera = Camera2D{ { 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, 1.0f };
+}
+
+// Centers the camera on the snake's head, clamped to the board edges
+// In a network match it follows the player's snake and holds still while that one respawns
+void Game::updateCamera() {
+    Position head = sim.getSnake().front();
+    if (networkMode) {
+        const MatchSnake* own = getOwnSnake();
+        if (!own || own->body.empty()) return;
+        head = own->body.front();
     }
+    float maxX = static_cast<float>((sim.getWidth() - viewWidth) * CELL_SIZE);
+    float maxY = static_cast<float>((sim.getHeight() - viewHeight) * CELL_SIZE);
+    float targetX = (head.x - viewWidth / 2) * CELL_SIZE;
+    float targetY = (head.y - viewHeight / 2) * CELL_SIZE;
+    camera.target.x = std::max(0.0f, std::min(maxX, targetX));
+    camera.target.y = std::max(0.0f, std::min(maxY, targetY));
+}
+
+// Returns true when a cell lies inside the viewport (with a one-cell margin for glows)
+bool Game::isCellVisible(Position pos) const {
+    int firstX = static_cast<int>(camera.target.x) / CELL_SIZE - 1;
+    int firstY = static_cast<int>(camera.target.y) / CELL_SIZE - 1;
+    return pos.x >= firstX && pos.x <= firstX + viewWidth + 2 &&
+           pos.y >= firstY && pos.y <= firstY + viewHeight + 2;
 }
 
 // Draws the UI panel with score, player info, and controls
 void Game::drawUI() {
-    int uiX = GRID_WIDTH * CELL_SIZE + 20;
+    const MatchSnake* own = networkMode ? getOwnSnake() : nullptr;
+    int score = networkMode ? (own ? own->getScore() : 0) : sim.getScore();
+
+    int uiX = viewWidth * CELL_SIZE + 20;
     int currentY = 20;
 
-    DrawTextEx(font, "SNAKE GAME", { (float)uiX, (float)currentY }, 22, 1, colors.accent);
+    DrawTextEx(fonts.get(22), "SNAKE GAME", { (float)uiX, (float)currentY }, 22, 1, colors.accent);
     currentY += 25;
-    DrawTextEx(font, "Modern Edition", { (float)uiX, (float)currentY }, 16, 1, colors.ui);
+    DrawTextEx(fonts.get(16), "Modern Edition", { (float)uiX, (float)currentY }, 16, 1, colors.ui);
     currentY += 35;
 
-    DrawTextEx(font, ("Player: " + playerName).c_str(), { (float)uiX, (float)currentY }, 18, 1, colors.success);
+    DrawTextEx(fonts.get(18), playerText.c_str(), { (float)uiX, (float)currentY }, 18, 1, colors.success);
     currentY += 25;
 
-    DrawTextEx(font, ("Score: " + std::to_string(score)).c_str(), { (float)uiX, (float)currentY }, 20, 1, WHITE);
+    scoreLabel.update(fonts, score);
+    DrawTextEx(fonts.get(scoreLabel.fontSize), scoreLabel.c_str(), { (float)uiX, (float)currentY }, scoreLabel.fontSize, 1, WHITE);
     currentY += 25;
     
-    DrawTextEx(font, ("Your Best: " + std::to_string(personalBestScore)).c_str(), { (float)uiX, (float)currentY }, 16, 1, colors.warning);
+    personalBestLabel.update(fonts, personalBestScore);
+    DrawTextEx(fonts.get(personalBestLabel.fontSize), personalBestLabel.c_str(), { (float)uiX, (float)currentY }, personalBestLabel.fontSize, 1, colors.warning);
     currentY += 25;
     
-    DrawTextEx(font, ("Best Overall: " + std::to_string(overallHighestScore)).c_str(), { (float)uiX, (float)currentY }, 16, 1, colors.accent);
+    overallBestLabel.update(fonts, overallHighestScore);
+    DrawTextEx(fonts.get(overallBestLabel.fontSize), overallBestLabel.c_str(), { (float)uiX, (float)currentY }, overallBestLabel.fontSize, 1, colors.accent);
     currentY += 35;
 
-    int speedLevel = getDifficultyLevel();
-    DrawTextEx(font, ("Speed Level: " + std::to_string(speedLevel)).c_str(), { (float)uiX, (float)currentY }, 16, 1, colors.warning);
+    if (networkMode) {
+        playersLabel.update(fonts, static_cast<int>(match.getPlayerCount()));
+        DrawTextEx(fonts.get(playersLabel.fontSize), playersLabel.c_str(), { (float)uiX, (float)currentY }, playersLabel.fontSize, 1, colors.warning);
+    } else {
+        speedLabel.update(fonts, getDifficultyLevel());
+        DrawTextEx(fonts.get(speedLabel.fontSize), speedLabel.c_str(), { (float)uiX, (float)currentY }, speedLabel.fontSize, 1, colors.warning);
+    }
     currentY += 35;
 
-    DrawTextEx(font, "Controls:", { (float)uiX, (float)currentY }, 18, 1, colors.accent);
+    DrawTextEx(fonts.get(18), "Controls:", { (float)uiX, (float)currentY }, 18, 1, colors.accent);
     currentY += 25;
     
     const char* controls[] = {"WASD/Arrows - Move", "P/Space - Pause", "Q/Esc - Menu", "L - Leaderboard"};
     for (int i = 0; i < 4; ++i) {
-        DrawTextEx(font, controls[i], { (float)uiX, (float)currentY }, 14, 1, colors.ui);
+        DrawTextEx(fonts.get(14), controls[i], { (float)uiX, (float)currentY }, 14, 1, colors.ui);
         currentY += 20;
     }
+
+    if (networkMode) {
+        const char* status = !netClient.hasJoined() ? "Connecting..." : (own && own->alive ? "Online match" : "Respawning...");
+        DrawTextEx(fonts.get(16), status, { (float)uiX, (float)currentY + 15 }, 16, 1, colors.warning);
+    } else if (replayMode) {
+        DrawTextEx(fonts.get(16), "Watching replay", { (float)uiX, (float)currentY + 15 }, 16, 1, colors.warning);
+    } else if (autopilotMode) {
+        DrawTextEx(fonts.get(16), "Autopilot", { (float)uiX, (float)currentY + 15 }, 16, 1, colors.warning);
+    }
+    if (showProfiler) drawProfilerOverlay(uiX, currentY + 45);
+}
+
+// Draws recent frame timings, ticks and allocations in the side panel (toggled with F3)
+// Lines are formatted into a stack buffer so the overlay does not allocate itself
+void Game::drawProfilerOverlay(int x, int y) {
+    ProfileSummary summary = profiler.summarize(PROFILE_WINDOW);
+    char line[64];
+
+    DrawTextEx(fonts.get(14), "Profiler (avg / max ms)", { (float)x, (float)y }, 14, 1, colors.accent);
+    y += 18;
+    for (int p = 0; p < static_cast<int>(ProfilePhase::COUNT); ++p) {
+        snprintf(line, sizeof(line), "%-8s %6.2f / %6.2f", profiler.getPhaseName(static_cast<ProfilePhase>(p)),
+                 summary.averageMs[p], summary.maxMs[p]);
+        DrawTextEx(fonts.get(12), line, { (float)x, (float)y }, 12, 1, colors.ui);
+        y += 15;
+    }
+    snprintf(line, sizeof(line), "%-8s %6.2f / %6.2f", "frame", summary.averageFrameMs, summary.maxFrameMs);
+    DrawTextEx(fonts.get(12), line, { (float)x, (float)y }, 12, 1, colors.ui);
+    y += 15;
+    snprintf(line, sizeof(line), "ticks/frame %.2f  allocs/frame %.1f", summary.ticksPerFrame, summary.allocationsPerFrame);
+    DrawTextEx(fonts.get(12), line, { (float)x, (float)y }, 12, 1, colors.warning);
+    y += 15;
+    if (ALLOCATION_COUNTING) {
+        snprintf(line, sizeof(line), "allocs this round %llu", static_cast<unsigned long long>(profiler.getRoundAllocations()));
+    } else {
+        snprintf(line, sizeof(line), "allocs not counted (make PROFILE=1)");
+    }
+    DrawTextEx(fonts.get(12), line, { (float)x, (float)y }, 12, 1, colors.warning);
+    y += 15;
+    snprintf(line, sizeof(line), "input->move %.1f / %.1f ms", inputLatency.averageMs(), inputLatency.maxMs());
+    DrawTextEx(fonts.get(12), line, { (float)x, (float)y }, 12, 1, colors.ui);
 }
 
 // Draws the main menu
 void Game::drawMenu() {
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SCREEN_HEIGHT / 2;
-    
-    DrawTextEx(font, "SNAKE GAME", { (float)centerX - 120, (float)centerY - 150 }, 40, 2, colors.accent);
-    DrawTextEx(font, "Modern Edition", { (float)centerX - 75, (float)centerY - 100 }, 20, 1, colors.ui);
+    int centerX = screenWidth / 2;
+    int centerY = screenHeight / 2;
     
-    std::string welcomeText = "Welcome, " + playerName + "!";
-    Vector2 textSize = MeasureTextEx(font, welcomeText.c_str(), 18, 1);
-    DrawTextEx(font, welcomeText.c_str(), { (float)centerX - textSize.x/2, (float)centerY - 60 }, 18, 1, colors.success);
+    DrawTextEx(fonts.get(40), "SNAKE GAME", { (float)centerX - 120, (float)centerY - 150 }, 40, 2, colors.accent);
+    DrawTextEx(fonts.get(20), "Modern Edition", { (float)centerX - 75, (float)centerY - 100 }, 20, 1, colors.ui);
     
-    std::string highestText = "Highest Score: " + std::to_string(overallHighestScore);
-    Vector2 highestSize = MeasureTextEx(font, highestText.c_str(), 14, 1);
-    DrawTextEx(font, highestText.c_str(), { (float)centerX - highestSize.x/2, (float)centerY - 35 }, 14, 1, colors.warning);
+    DrawTextEx(fonts.get(18), welcomeText.c_str(), { (float)centerX - welcomeSize.x/2, (float)centerY - 60 }, 18, 1, colors.success);
     
-    std::string personalText = "Your Best: " + std::to_string(personalBestScore);
-    Vector2 personalSize = MeasureTextEx(font, personalText.c_str(), 14, 1);
-    DrawTextEx(font, personalText.c_str(), { (float)centerX - personalSize.x/2, (float)centerY - 15 }, 14, 1, colors.ui);
+    if (!startupFinished) {
+        DrawTextEx(fonts.get(14), "Loading scores...", { (float)centerX - 55, (float)centerY - 25 }, 14, 1, colors.ui);
+    } else {
+        menuHighestLabel.update(fonts, overallHighestScore);
+        DrawTextEx(fonts.get(menuHighestLabel.fontSize), menuHighestLabel.c_str(), { (float)centerX - menuHighestLabel.size.x/2, (float)centerY - 35 },
+                   menuHighestLabel.fontSize, 1, colors.warning);
+
+        menuPersonalLabel.update(fonts, personalBestScore);
+        DrawTextEx(fonts.get(menuPersonalLabel.fontSize), menuPersonalLabel.c_str(), { (float)centerX - menuPersonalLabel.size.x/2, (float)centerY - 15 },
+                   menuPersonalLabel.fontSize, 1, colors.ui);
+    }
     
-    const char* menuItems[] = {"Start Game", "Leaderboard", "Settings", "Exit"};
-    for (int i = 0; i < 4; ++i) {
+    const char* menuItems[] = {"Start Game", "Autopilot", "Leaderboard", "Settings", "Exit"};
+    for (int i = 0; i < 5; ++i) {
         bool selected = (i == selectedMenuItem);
         Color textColor = selected ? colors.accent : colors.ui;
         if (selected) DrawRectangle(centerX - 100, centerY + 20 + i * 40 - 5, 200, 30, Fade(colors.accent, 0.2f));
-        DrawTextEx(font, menuItems[i], { (float)centerX - 60, (float)centerY + 20 + i * 40 }, 18, 1, textColor);
-        if (selected) DrawTextEx(font, ">", { (float)centerX - 80, (float)centerY + 20 + i * 40 }, 18, 1, colors.accent);
+        DrawTextEx(fonts.get(18), menuItems[i], { (float)centerX - 60, (float)centerY + 20 + i * 40 }, 18, 1, textColor);
+        if (selected) DrawTextEx(fonts.get(18), ">", { (float)centerX - 80, (float)centerY + 20 + i * 40 }, 18, 1, colors.accent);
     }
     
-    DrawTextEx(font, "Use W/S or Arrows to navigate, Enter to select", { (float)centerX - 200, (float)SCREEN_HEIGHT - 60 }, 14, 1, colors.ui);
-    DrawTextEx(font, "Speed increases automatically as you eat!", { (float)centerX - 150, (float)SCREEN_HEIGHT - 40 }, 12, 1, colors.warning);
+    DrawTextEx(fonts.get(14), "Use W/S or Arrows to navigate, Enter to select", { (float)centerX - 200, (float)screenHeight - 60 }, 14, 1, colors.ui);
+    DrawTextEx(fonts.get(12), "Speed increases automatically as you eat!", { (float)centerX - 150, (float)screenHeight - 40 }, 12, 1, colors.warning);
+}
+
+// Rebuilds the label text and its size when the shown value changed
+void CachedLabel::update(const FontAtlas& fonts, int newValue) {
+    if (built && newValue == value) return;
+    value = newValue;
+    text.assign(prefix);
+    text += std::to_string(newValue);
+    size = MeasureTextEx(fonts.get(fontSize), text.c_str(), fontSize, 1);
+    built = true;
 }
 
 // Draws the game over screen
 void Game::drawGameOver() {
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SCREEN_HEIGHT / 2;
+    int score = sim.getScore();
+    int centerX = screenWidth / 2;
+    int centerY = screenHeight / 2;
 
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
+    DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.7f));
     DrawRectangle(centerX - 200, centerY - 150, 400, 300, Fade(colors.background, 0.95f));
     DrawRectangleLines(centerX - 200, centerY - 150, 400, 300, colors.accent);
 
-    DrawTextEx(font, "GAME OVER", { (float)centerX - 80, (float)centerY - 120 }, 28, 2, colors.warning);
-    DrawTextEx(font, ("Final Score: " + std::to_string(score)).c_str(), { (float)centerX - 70, (float)centerY - 80 }, 20, 1, WHITE);
+    DrawTextEx(fonts.get(28), "GAME OVER", { (float)centerX - 80, (float)centerY - 120 }, 28, 2, colors.warning);
+    finalScoreLabel.update(fonts, score);
+    DrawTextEx(fonts.get(finalScoreLabel.fontSize), finalScoreLabel.c_str(), { (float)centerX - 70, (float)centerY - 80 }, finalScoreLabel.fontSize, 1, WHITE);
+
+    if (!sim.hasFood()) {
+        DrawTextEx(fonts.get(18), "BOARD CLEARED!", { (float)centerX - 70, (float)centerY - 60 }, 18, 1, colors.success);
+    }
 
     if (score > personalBestScore && personalBestScore > 0) {
-        DrawTextEx(font, "NEW PERSONAL BEST!", { (float)centerX - 85, (float)centerY - 40 }, 18, 1, colors.success);
+        DrawTextEx(fonts.get(18), "NEW PERSONAL BEST!", { (float)centerX - 85, (float)centerY - 40 }, 18, 1, colors.success);
     } else if (score > overallHighestScore && overallHighestScore > 0) {
-        DrawTextEx(font, "NEW HIGHEST SCORE!", { (float)centerX - 85, (float)centerY - 20 }, 18, 1, colors.warning);
+        DrawTextEx(fonts.get(18), "NEW HIGHEST SCORE!", { (float)centerX - 85, (float)centerY - 20 }, 18, 1, colors.warning);
     }
 
-    DrawTextEx(font, "R - Restart Game", { (float)centerX - 65, (float)centerY + 75 }, 16, 1, colors.accent);
-    DrawTextEx(font, "L - View Leaderboard", { (float)centerX - 80, (float)centerY + 95 }, 16, 1, colors.accent);
-    DrawTextEx(font, "Q - Return to Menu", { (float)centerX - 75, (float)centerY + 115 }, 16, 1, colors.accent);
+    DrawTextEx(fonts.get(16), "R - Restart Game", { (float)centerX - 65, (float)centerY + 75 }, 16, 1, colors.accent);
+    DrawTextEx(fonts.get(16), "L - View Leaderboard", { (float)centerX - 80, (float)centerY + 95 }, 16, 1, colors.accent);
+    DrawTextEx(fonts.get(16), "Q - Return to Menu", { (float)centerX - 75, (float)centerY + 115 }, 16, 1, colors.accent);
 }
 
 // Draws the leaderboard screen
 void Game::drawLeaderboard() {
-    int centerX = SCREEN_WIDTH / 2;
+    int centerX = screenWidth / 2;
     int startY = 100;
 
-    DrawTextEx(font, "LEADERBOARD", { (float)centerX - 90, 50 }, 32, 2, colors.accent);
+    DrawTextEx(fonts.get(32), "LEADERBOARD", { (float)centerX - 90, 50 }, 32, 2, colors.accent);
 
-    if (leaderboard.empty()) {
-        DrawTextEx(font, "No scores yet. Be the first!", { (float)centerX - 100, (float)startY + 50 }, 20, 1, colors.ui);
+    if (!startupFinished) {
+        DrawTextEx(fonts.get(20), "Loading leaderboard...", { (float)centerX - 100, (float)startY + 50 }, 20, 1, colors.ui);
+    } else if (leaderboard.empty()) {
+        DrawTextEx(fonts.get(20), "No scores yet. Be the first!", { (float)centerX - 100, (float)startY + 50 }, 20, 1, colors.ui);
     } else {
-        DrawTextEx(font, "Rank", { 50, (float)startY }, 16, 1, colors.accent);
-        DrawTextEx(font, "Player", { 150, (float)startY }, 16, 1, colors.accent);
-        DrawTextEx(font, "Score", { 350, (float)startY }, 16, 1, colors.accent);
-        DrawLine(50, startY + 25, SCREEN_WIDTH - 50, startY + 25, colors.grid);
+        DrawTextEx(fonts.get(16), "Rank", { 50, (float)startY }, 16, 1, colors.accent);
+        DrawTextEx(fonts.get(16), "Player", { 150, (float)startY }, 16, 1, colors.accent);
+        DrawTextEx(fonts.get(16), "Score", { 350, (float)startY }, 16, 1, colors.accent);
+        DrawLine(50, startY + 25, screenWidth - 50, startY + 25, colors.grid);
 
         for (size_t i = 0; i < std::min(leaderboard.size(), (size_t)MAX_LEADERBOARD_ENTRIES); ++i) {
             int y = startY + 40 + i * 30;
             bool isCurrentPlayer = (leaderboard[i].name == playerName);
-            if (isCurrentPlayer) DrawRectangle(40, y - 5, SCREEN_WIDTH - 80, 25, Fade(colors.accent, 0.2f));
+            if (isCurrentPlayer) DrawRectangle(40, y - 5, screenWidth - 80, 25, Fade(colors.accent, 0.2f));
 
-            DrawTextEx(font, std::to_string(i + 1).c_str(), { 50, (float)y }, 16, 1, colors.ui);
-            DrawTextEx(font, leaderboard[i].name.c_str(), { 150, (float)y }, 16, 1, isCurrentPlayer ? colors.success : colors.ui);
-            DrawTextEx(font, std::to_string(leaderboard[i].score).c_str(), { 350, (float)y }, 16, 1, isCurrentPlayer ? colors.success : colors.ui);
+            DrawTextEx(fonts.get(16), std::to_string(i + 1).c_str(), { 50, (float)y }, 16, 1, colors.ui);
+            DrawTextEx(fonts.get(16), leaderboard[i].name.c_str(), { 150, (float)y }, 16, 1, isCurrentPlayer ? colors.success : colors.ui);
+            DrawTextEx(fonts.get(16), std::to_string(leaderboard[i].score).c_str(), { 350, (float)y }, 16, 1, isCurrentPlayer ? colors.success : colors.ui);
+        }
+        if (!rankText.empty()) {
+            float y = startY + 50 + leaderboard.size() * 30;
+            DrawTextEx(fonts.get(16), rankText.c_str(), { 50, y }, 16, 1, colors.success);
         }
     }
-    DrawTextEx(font, "Press Q or Escape to return to menu", { (float)centerX - 140, (float)SCREEN_HEIGHT - 50 }, 14, 1, colors.ui);
+    DrawTextEx(fonts.get(14), "Press Q or Escape to return to menu", { (float)centerX - 140, (float)screenHeight - 50 }, 14, 1, colors.ui);
 }
 
 // Draws the settings screen
 void Game::drawSettings() {
-    int centerX = SCREEN_WIDTH / 2;
+    int centerX = screenWidth / 2;
     int startY = 200;
 
-    DrawTextEx(font, "SETTINGS", { (float)centerX - 70, 50 }, 32, 2, colors.accent);
+    DrawTextEx(fonts.get(32), "SETTINGS", { (float)centerX - 70, 50 }, 32, 2, colors.accent);
     
-    DrawTextEx(font, "Speed increases automatically with score!", { (float)centerX - 140, 100 }, 14, 1, colors.warning);
+    DrawTextEx(fonts.get(14), "Speed increases automatically with score!", { (float)centerX - 140, 100 }, 14, 1, colors.warning);
     
-    DrawTextEx(font, "Show Grid", { (float)centerX - 100, (float)startY }, 18, 1, colors.accent);
-    DrawTextEx(font, showGrid ? "ON" : "OFF", { (float)centerX + 50, (float)startY }, 18, 1, showGrid ? colors.success : colors.warning);
-    DrawTextEx(font, "Press Enter to toggle", { (float)centerX - 80, (float)startY + 25 }, 12, 1, colors.ui);
+    DrawTextEx(fonts.get(18), "Show Grid", { (float)centerX - 100, (float)startY }, 18, 1, selectedMenuItem == 0 ? colors.accent : colors.ui);
+    DrawTextEx(fonts.get(18), showGrid ? "ON" : "OFF", { (float)centerX + 50, (float)startY }, 18, 1, showGrid ? colors.success : colors.warning);
+
+    DrawTextEx(fonts.get(18), "Incremental", { (float)centerX - 100, (float)startY + 30 }, 18, 1, selectedMenuItem == 1 ? colors.accent : colors.ui);
+    DrawTextEx(fonts.get(18), incrementalRender ? "ON" : "OFF", { (float)centerX + 50, (float)startY + 30 }, 18, 1, incrementalRender ? colors.success : colors.warning);
+    if (incrementalRender && bodyShader.id == rlGetShaderIdDefault()) {
+        DrawTextEx(fonts.get(12), "Not supported here, drawing everything", { (float)centerX - 100, (float)startY + 52 }, 12, 1, colors.warning);
+    }
+
+    const char* levelLabel = startupFinished ? "Default" : "...";
+    const char* levelStatus = startupFinished ? "" : "Loading...";
+    if (startupFinished && levelIndex >= 0) {
+        levelLabel = levelPack.getName(levelIndex).c_str();
+        if (levelPack.isFailed(levelIndex)) levelStatus = "Could not read this level";
+        else if (!levelPack.get(levelIndex)) levelStatus = "Loading...";
+    }
+    DrawTextEx(fonts.get(18), "Level", { (float)centerX - 100, (float)startY + 75 }, 18, 1, selectedMenuItem == 2 ? colors.accent : colors.ui);
+    DrawTextEx(fonts.get(18), levelLabel, { (float)centerX + 50, (float)startY + 75 }, 18, 1, colors.success);
+    if (levelStatus[0] != '\0') {
+        DrawTextEx(fonts.get(12), levelStatus, { (float)centerX - 100, (float)startY + 97 }, 12, 1, colors.warning);
+    }
+
+    DrawTextEx(fonts.get(12), "Up/Down to select, Enter to toggle, Left/Right for levels", { (float)centerX - 100, (float)startY + 120 }, 12, 1, colors.ui);
     
-    DrawTextEx(font, "Q/Escape - Back to Menu", { (float)centerX - 90, (float)SCREEN_HEIGHT - 50 }, 14, 1, colors.ui);
+    DrawTextEx(fonts.get(14), "Q/Escape - Back to Menu", { (float)centerX - 90, (float)screenHeight - 50 }, 14, 1, colors.ui);
 }
 
 // Draws the pause overlay
 void Game::drawPauseOverlay() {
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SCREEN_HEIGHT / 2;
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
+    int centerX = screenWidth / 2;
+    int centerY = screenHeight / 2;
+    DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.5f));
     DrawRectangle(centerX - 100, centerY - 60, 200, 120, Fade(colors.background, 0.95f));
     DrawRectangleLines(centerX - 100, centerY - 60, 200, 120, colors.accent);
-    DrawTextEx(font, "PAUSED", { (float)centerX - 35, (float)centerY - 40 }, 20, 1, colors.accent);
-    DrawTextEx(font, "Press P to continue", { (float)centerX - 75, (float)centerY - 10 }, 14, 1, colors.ui);
-    DrawTextEx(font, "Press Q for menu", { (float)centerX - 70, (float)centerY + 15 }, 14, 1, colors.ui);
+    DrawTextEx(fonts.get(20), "PAUSED", { (float)centerX - 35, (float)centerY - 40 }, 20, 1, colors.accent);
+    DrawTextEx(fonts.get(14), "Press P to continue", { (float)centerX - 75, (float)centerY - 10 }, 14, 1, colors.ui);
+    DrawTextEx(fonts.get(14), "Press Q for menu", { (float)centerX - 70, (float)centerY + 15 }, 14, 1, colors.ui);
 }
 
 // Draws a progress bar (not used in main UI)
@@ -374,13 +929,13 @@ void Game::drawProgressBar(int x, int y, int width, int height, float progress,
     DrawRectangleLines(x, y, width, height, colors.ui);
 }
 
-// Draws a glow effect around a position
-void Game::drawGlowEffect(Position pos, Color color, float intensity) {
-    int centerX = pos.x * CELL_SIZE + CELL_SIZE / 2;
-    int centerY = pos.y * CELL_SIZE + CELL_SIZE / 2;
+// Queues a glow effect around a cell (fractional cells allowed for interpolated heads)
+void Game::drawGlowEffect(Vector2 cell, Color color, float intensity) {
+    float centerX = cell.x * CELL_SIZE + CELL_SIZE / 2;
+    float centerY = cell.y * CELL_SIZE + CELL_SIZE / 2;
     Color glowColor = color;
     glowColor.a = static_cast<unsigned char>(100 * intensity);
-    DrawCircle(centerX, centerY, CELL_SIZE * 0.8f * intensity, glowColor);
+    fieldBatch.addCircle(centerX, centerY, CELL_SIZE * 0.8f * intensity, glowColor);
 }
 
 // Updates animation timers
@@ -388,193 +943,31 @@ void Game::updateAnimations(float deltaTime) {
     animationTimer += deltaTime;
 }
 
-// Initializes the snake to starting position and direction
-void Game::initializeSnake() {
-    snake.clear();
-    snake.push_back({GRID_WIDTH / 2, GRID_HEIGHT / 2});
-    snake.push_back({GRID_WIDTH / 2, GRID_HEIGHT / 2 + 1});
-    snake.push_back({GRID_WIDTH / 2, GRID_HEIGHT / 2 + 2});
-    currentDirection = Direction::UP;
-    nextDirection = Direction::UP;
-}
-
-// Generates food at a random empty position
-void Game::generateFood() {
-    std::vector<Position> emptyPositions;
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            Position pos = {x, y};
-            bool isEmpty = true;
-            for (const auto& segment : snake) if (segment == pos) { isEmpty = false; break; }
-            if (isEmpty) {
-                for (const auto& obs : obstacles) if (obs == pos) { isEmpty = false; break; }
-            }
-            if (isEmpty) emptyPositions.push_back(pos);
-        }
-    }
-    if (!emptyPositions.empty()) {
-        food = emptyPositions[rand() % emptyPositions.size()];
-    }
-}
-
-// Moves the snake in the current direction
-void Game::moveSnake() {
-    Position newHead = snake.front();
-    switch (currentDirection) {
-        case Direction::UP:    newHead.y--; break;
-        case Direction::DOWN:  newHead.y++; break;
-        case Direction::LEFT:  newHead.x--; break;
-        case Direction::RIGHT: newHead.x++; break;
-    }
-    snake.push_front(newHead);
-}
-
-// Checks for collisions with walls, self, or obstacles
-bool Game::checkCollision() {
-    Position head = snake.front();
-    if (head.x < 0 || head.x >= GRID_WIDTH || head.y < 0 || head.y >= GRID_HEIGHT) return true;
-    for (size_t i = 1; i < snake.size(); ++i) if (snake[i] == head) return true;
-    for (const auto& obs : obstacles) if (obs == head) return true;
-    return false;
-}
-
-// Loads obstacles from a file
-void Game::loadObstacles(const std::string& filename) {
-    obstacles.clear();
-    std::ifstream file(filename);
-    if (file.is_open()) {
-        int x, y;
-        while (file >> x >> y && obstacles.size() < MAX_OBSTACLES) {
-            if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT) {
-                obstacles.push_back({x, y});
-            }
-        }
-    }
-}
-
-// Loads the highest scores from file
+// Reads the overall and personal bests from the score store
 void Game::loadHighestScores() {
-    overallHighestScore = 0;
-    personalBestScore = 0;
-    std::ifstream file("user_scores.txt");
-    if (file.is_open()) {
-        std::string name;
-        int score;
-        while (file >> name >> score) {
-            if (score > overallHighestScore) {
-                overallHighestScore = score;
-            }
-            if (name == playerName && score > personalBestScore) {
-                personalBestScore = score;
-            }
-        }
-    }
+    std::vector<ScoreEntry> best = scoreStore.top(1);
+    overallHighestScore = best.empty() ? 0 : best[0].score;
+    personalBestScore = scoreStore.getBest(playerName);
 }
 
-// Saves the player's personal best score
-void Game::savePersonalBest() {
-    if (score <= personalBestScore) return;
-
-    std::map<std::string, int> userScores;
-    std::ifstream inFile("user_scores.txt");
-    if (inFile.is_open()) {
-        std::string name;
-        int existingScore;
-        while (inFile >> name >> existingScore) {
-            userScores[name] = existingScore;
-        }
-    }
-    
-    userScores[playerName] = score;
-    
-    std::ofstream outFile("user_scores.txt");
-    if (outFile.is_open()) {
-        for (const auto& pair : userScores) {
-            outFile << pair.first << " " << pair.second << "\n";
-        }
-    }
-    
-    personalBestScore = score;
-    if (score > overallHighestScore) {
-        overallHighestScore = score;
-    }
-}
-
-// Saves the best score for the session
-void Game::saveSessionBestScore() {
-    std::map<std::string, int> userScores;
-    std::ifstream inFile("user_scores.txt");
-    if (inFile.is_open()) {
-        std::string name;
-        int existingScore;
-        while (inFile >> name >> existingScore) {
-            if (userScores.find(name) == userScores.end() || existingScore > userScores[name]) {
-                userScores[name] = existingScore;
-            }
-        }
-    }
-    
-    std::ofstream outFile("user_scores.txt");
-    if (outFile.is_open()) {
-        for (const auto& pair : userScores) {
-            outFile << pair.first << " " << pair.second << "\n";
-        }
-    }
-}
-
-// Loads the leaderboard from file
+// Refreshes the shown leaderboard and the player's rank from the store
+// Both are rewritten in place, so a refresh after game over reuses their storage
 void Game::loadLeaderboard() {
-    leaderboard.clear();
-    std::map<std::string, int> bestScores;
-    
-    std::ifstream file("scores.txt");
-    if (file.is_open()) {
-        std::string name;
-        int scoreVal;
-        while (file >> name >> scoreVal) {
-            if (bestScores.find(name) == bestScores.end() || scoreVal > bestScores[name]) {
-                bestScores[name] = scoreVal;
-            }
-        }
-        
-        for (const auto& pair : bestScores) {
-            leaderboard.push_back({pair.first, pair.second});
-        }
-        
-        std::sort(leaderboard.begin(), leaderboard.end());
-    }
+    scoreStore.top(MAX_LEADERBOARD_ENTRIES, leaderboard);
+    size_t rank = scoreStore.getRank(playerName);
+    char text[64] = "";
+    if (rank > 0) snprintf(text, sizeof(text), "Your rank: %zu of %zu", rank, scoreStore.size());
+    rankText.assign(text);
 }
 
-// Saves the current score to the leaderboard
-void Game::saveToLeaderboard() {
-    if (score > 0) {
-        bool playerExists = false;
-        for (auto& entry : leaderboard) {
-            if (entry.name == playerName) {
-                playerExists = true;
-                if (score > entry.score) {
-                    entry.score = score;
-                }
-                break;
-            }
-        }
-        
-        if (!playerExists) {
-            leaderboard.push_back({playerName, score});
-        }
-        
-        std::sort(leaderboard.begin(), leaderboard.end());
-        if (leaderboard.size() > MAX_LEADERBOARD_ENTRIES) {
-            leaderboard.resize(MAX_LEADERBOARD_ENTRIES);
-        }
-        
-        std::ofstream file("scores.txt");
-        if (file.is_open()) {
-            for (const auto& entry : leaderboard) {
-                file << entry.name << " " << entry.score << "\n";
-            }
-        }
-    }
+// Records the finished round; only a new personal best touches the store and its file
+void Game::saveScore() {
+    int score = sim.getScore();
+    if (score <= 0 || !scoreStore.record(playerName, score)) return;
+
+    personalBestScore = score;
+    overallHighestScore = std::max(overallHighestScore, score);
+    loadLeaderboard();
 }
 
 // Loads settings from file
@@ -582,6 +975,15 @@ void Game::loadSettings() {
     std::ifstream file("settings.txt");
     if (file.is_open()) {
         file >> showGrid;
+        int width, height;
+        if (file >> width >> height) {
+            boardWidth = width;
+            boardHeight = height;
+        }
+        bool incremental;
+        if (file >> incremental) incrementalRender = incremental;
+        std::string level;
+        if (std::getline(file >> std::ws, level)) levelName = level;
     }
 }
 
@@ -589,7 +991,7 @@ void Game::loadSettings() {
 void Game::saveSettings() {
     std::ofstream file("settings.txt");
     if (file.is_open()) {
-        file << showGrid;
+        file << showGrid << "\n" << boardWidth << " " << boardHeight << "\n" << incrementalRender << "\n" << levelName << "\n";
     }
 }
 
@@ -597,18 +999,62 @@ void Game::saveSettings() {
 void Game::changeState(GameState newState) {
     currentState = newState;
     selectedMenuItem = 0;
-    if (newState == GameState::LEADERBOARD) {
-        loadLeaderboard();
+    redrawRequested = true;
+    restartTimer = 0.0f;
+    if (newState != GameState::PLAYING) inputQueue.clear();  // Turns do not carry over a pause or a new round
+    // High-rate polling paces playing frames itself; every other screen keeps raylib's frame cap
+    if (inputPollRate > 0) SetTargetFPS(newState == GameState::PLAYING ? 0 : targetFps);
+    if (isIdleState(newState) && startupFinished && !networkMode) EnableEventWaiting();
+    else DisableEventWaiting();
+}
+
+// Network play: applies what arrived from the server, mirrors a new board into sim and sends
+// the next queued turn, at most one per tick like the local queue
+void Game::updateMatch() {
+    int ticks = netClient.poll(match);
+    if (ticks < 0) throw std::runtime_error("Lost the connection to the server");
+    for (int i = 0; i < ticks; ++i) profiler.countTick();
+    if (ticks > 0) turnSent = false;
+
+    if (match.getLayoutVersion() != matchLayoutVersion) {
+        matchLayoutVersion = match.getLayoutVersion();
+        // sim only sizes the view and versions the static layer; its obstacles are not the ones drawn
+        sim.resize(match.getWidth(), match.getHeight());
+        sim.setObstacles(match.getObstacles());
+        sim.reset();
+        configureViewport();
+        SetWindowSize(screenWidth, screenHeight);
+    }
+
+    InputEvent input;
+    if (!turnSent && currentState == GameState::PLAYING && inputQueue.pop(input)) {
+        netClient.sendTurn(input.direction);
+        turnSent = true;
     }
 }
 
+// Returns the player's snake in the network match, or nullptr before the server assigned one
+const MatchSnake* Game::getOwnSnake() const {
+    const auto& snakes = match.getSnakes();
+    if (!netClient.hasJoined() || netClient.getSnakeId() >= snakes.size()) return nullptr;
+    return &snakes[netClient.getSnakeId()];
+}
+
+// Returns true for screens that only change in response to input
+bool Game::isIdleState(GameState state) {
+    return state == GameState::MENU || state == GameState::LEADERBOARD ||
+           state == GameState::SETTINGS || state == GameState::PAUSED;
+}
+
 // Returns the current difficulty level based on score
 int Game::getDifficultyLevel() const {
+    int score = sim.getScore();
     return (score / 50) + 1;
 }
 
 // Calculates the snake's movement speed based on score
 float Game::calculateSpeed() const {
+    int score = sim.getScore();
     float baseSpeed = 0.15f;
     float speedIncrease = (score / 30) * 0.02f;
     float minSpeed = 0.05f;
@@ -617,9 +1063,86 @@ float Game::calculateSpeed() const {
 
 // Resets the game to initial state
 void Game::reset() {
-    initializeSnake();
-    generateFood();
-    score = 0;
+    if (!replayMode && !networkMode) applyLevel();
+    roundSeed = replayMode ? playback.seed : sessionRng.next();
+    replayPlayer.rewind();
+    sim.seed(roundSeed);
+    sim.reset();
+    recorder.begin(roundSeed, sim);
+    previousHead = sim.getSnake().front();
+    previousTail = sim.getSnake().back();
+    bodyLayerStale = true;
+    nextDirection = sim.getDirection();
+    inputQueue.clear();
+    autopilot.resize(sim.getWidth(), sim.getHeight());
+    autopilot.reset();
     moveTimer = 0.0f;
     animationTimer = 0.0f;
-}
\ No newline at end of file
+    profiler.beginRound();
+}
+
+// Starts a round from the menu, a restart or an autopilot restart, with the keyboard or the autopilot steering
+void Game::startRound(bool autopilotRound) {
+    finishStartup(true);
+    autopilotMode = autopilotRound && !networkMode;  // The autopilot only knows the local rules
+    reset();
+    changeState(GameState::PLAYING);
+}
+
+// Copies the selected level into the simulation if it is loaded and not already active
+// A level still loading leaves the current one in place until a later round
+void Game::applyLevel() {
+    if (!startupFinished) return;
+    const Level* level = levelIndex < 0 ? &baseLevel : levelPack.get(levelIndex);
+    if (!level || level == activeLevel) return;
+
+    bool resized = level->width != sim.getWidth() || level->height != sim.getHeight();
+    sim.setLevel(*level);
+    activeLevel = level;
+    if (resized) {
+        configureViewport();
+        SetWindowSize(screenWidth, screenHeight);
+    }
+}
+
+// Chooses the level for the next round; the obstacle list is grown now rather than between rounds
+void Game::selectLevel(int index) {
+    levelIndex = index;
+    levelName = index < 0 ? std::string() : levelPack.getName(index);
+    const Level* level = index < 0 ? &baseLevel : levelPack.get(index);
+    if (level) {
+        sim.reserveObstacles(level->count);
+        recorder.reserve(REPLAY_EVENT_RESERVE, level->count);
+    }
+}
+
+// Startup loader thread: reads the score store, the --level map and the level pack index
+// The game thread leaves all three alone until finishStartup() has joined it
+void Game::loadStartupData(std::string levelPath, std::string packPath, int width, int height) {
+    scoreStore.preload();
+    // The --level map stays in memory next to the pack, so every switch is a bitmap copy
+    if (!loadLevel(levelPath, width, height, baseLevel)) {
+        baseLevel.width = width;
+        baseLevel.height = height;
+        baseLevel.cells = OccupancyGrid(static_cast<size_t>(width) * height);
+    }
+    levelPack.open(packPath, width, height);
+    startupLoaded.store(true, std::memory_order_release);
+}
+
+// Takes over the startup data, waiting for the loader if asked; false while it is still running
+bool Game::finishStartup(bool wait) {
+    if (startupFinished) return true;
+    if (!wait && !startupLoaded.load(std::memory_order_acquire)) return false;
+
+    startupLoader.join();
+    startupFinished = true;
+    if (!levelName.empty()) levelIndex = levelPack.find(levelName);
+    const Level* level = levelIndex < 0 ? &baseLevel : levelPack.get(levelIndex);
+    if (level) recorder.reserve(REPLAY_EVENT_RESERVE, level->count);
+    loadHighestScores();
+    loadLeaderboard();
+    if (isIdleState(currentState) && !networkMode) EnableEventWaiting();
+    redrawRequested = true;
+    return true;
+}
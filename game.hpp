@@ -10,27 +10,63 @@
 
 #include <vector>
 #include <string>
-#include <deque>
 #include <array>
+#include <thread>
+#include <atomic>
 #include "raylib.h"
+#include "snake_sim.hpp"
+#include "replay.hpp"
+#include "render_batch.hpp"
+#include "profiler.hpp"
+#include "font_atlas.hpp"
+#include "leaderboard.hpp"
+#include "persistence.hpp"
+#include "score_store.hpp"
+#include "level_pack.hpp"
+#include "input_queue.hpp"
+#include "autopilot.hpp"
+#include "match_sim.hpp"
+#include "net_client.hpp"
 
-struct Position {
-    int x, y;
-    bool operator==(const Position& other) const {
-        return x == other.x && y == other.y;
-    }
-};
+/**
+ * @brief A "prefix + number" UI label whose text and measured size are only
+ * rebuilt when the number changes, so steady-state frames do not allocate.
+ */
+struct CachedLabel {
+    CachedLabel(const char* prefix, float fontSize) : prefix(prefix), fontSize(fontSize) {}
+    void update(const FontAtlas& fonts, int newValue);
+    void invalidate() { built = false; }
+    const char* c_str() const { return text.c_str(); }
 
-struct ScoreEntry {
-    std::string name;
-    int score;
-    bool operator<(const ScoreEntry& other) const {
-        return score > other.score;
-    }
+    std::string prefix;
+    float fontSize;
+    std::string text;
+    Vector2 size = { 0.0f, 0.0f };
+    int value = 0;
+    bool built = false;
 };
 
-enum class Direction {
-    UP, DOWN, LEFT, RIGHT
+struct GameConfig {
+    int gridWidth = 0;   // Board width in cells; 0 keeps the value from settings.txt
+    int gridHeight = 0;  // Board height in cells; 0 keeps the value from settings.txt
+    bool fixedSeed = false;
+    uint64_t seed = 0;   // Session seed used when fixedSeed is set
+    std::string recordPath;  // Where to save the replay of each finished round
+    std::string replayPath;  // Replay to play back instead of keyboard input
+    bool fastReplay = false; // Verify replayPath headless at full speed instead of opening a window
+    int targetFps = 60;      // Render frame cap; 0 renders uncapped
+    bool vsync = false;      // Synchronise presentation with the display
+    std::string profilePath; // Where to export frame profiling samples on exit
+    bool renderBenchmark = false; // Measure renderer frame rates instead of playing
+    std::string levelPath = "obstacles.txt"; // Obstacle map, binary or text
+    std::string levelPackPath = "levels";    // Directory of extra levels selectable in settings
+    std::string convertLevelPath; // Write levelPath as a binary level here instead of playing
+    int inputRate = 0;       // Input polls per second while playing; 0 polls once per frame
+    std::string connectAddress; // snake_server to join as HOST:PORT instead of playing alone
+    bool headless = false;   // Evaluate a policy or verify replays without a window (headless.hpp)
+    uint64_t episodes = 1000;
+    std::string policy = "autopilot";
+    unsigned threads = 0;    // Headless worker threads; 0 uses every hardware thread
 };
 
 enum class GameState {
@@ -44,47 +80,146 @@ enum class GameState {
 
 class Game {
 public:
-    Game(const std::string& playerName);
+    Game(const std::string& playerName, const GameConfig& config = GameConfig());
     ~Game();
     void run();
+    void runRenderBenchmark();
 
 private:
     // Game Constants
     static constexpr int CELL_SIZE = 20;
-    static constexpr int GRID_WIDTH = 30;
-    static constexpr int GRID_HEIGHT = 20;
-    static constexpr int SCREEN_WIDTH = GRID_WIDTH * CELL_SIZE + 250;
-    static constexpr int SCREEN_HEIGHT = GRID_HEIGHT * CELL_SIZE + 150;
+    static constexpr int PANEL_WIDTH = 250;
+    static constexpr int FOOTER_HEIGHT = 150;
+    static constexpr int MAX_VIEW_WIDTH = 48;
+    static constexpr int MAX_VIEW_HEIGHT = 32;
+    static constexpr int MIN_SCREEN_WIDTH = SnakeSim::DEFAULT_WIDTH * CELL_SIZE + PANEL_WIDTH;
+    static constexpr int MIN_SCREEN_HEIGHT = SnakeSim::DEFAULT_HEIGHT * CELL_SIZE + FOOTER_HEIGHT;
     static constexpr int MAX_LEADERBOARD_ENTRIES = 10;
-    static constexpr int MAX_OBSTACLES = 100;
+    static constexpr int MAX_TICKS_PER_FRAME = 8;
+    static constexpr int PROFILE_WINDOW = 60;   // Frames averaged by the profiler overlay
+    static constexpr float AUTOPILOT_RESTART_DELAY = 3.0f;  // Seconds an autopilot round's game over stays up
+    static constexpr size_t REPLAY_EVENT_RESERVE = 1 << 16;  // Bytes of recorded turns a round fills before growing
     
     // Game State
     GameState currentState;
-    std::deque<Position> snake;
-    Position food;
-    std::vector<Position> obstacles;
-    Direction currentDirection;
+    SnakeSim sim;
     Direction nextDirection;
+    Position previousHead;    // Head and tail before the last tick, for interpolated drawing
+    Position previousTail;
     
     // Scoring & Timers
-    int score;
     int overallHighestScore;
     int personalBestScore;
-    float moveTimer;
+    float moveTimer;          // Fixed-timestep accumulator; carries the remainder between ticks
     float moveInterval;
     float animationTimer;
     
     // Player & UI
     std::string playerName;
-    std::vector<ScoreEntry> leaderboard;
+    std::vector<ScoreEntry> leaderboard;  // Top entries of scoreStore, refreshed when it changes
     int selectedMenuItem;
+
+    // Cached UI text, rebuilt on change instead of every frame
+    std::string playerText;
+    std::string welcomeText;
+    Vector2 welcomeSize;
+    CachedLabel scoreLabel;
+    CachedLabel personalBestLabel;
+    CachedLabel overallBestLabel;
+    CachedLabel speedLabel;
+    CachedLabel finalScoreLabel;
+    CachedLabel menuHighestLabel;
+    CachedLabel menuPersonalLabel;
+    CachedLabel playersLabel;
     
+    // Randomness: each round gets a seed drawn from the session generator
+    Rng sessionRng;
+    uint64_t roundSeed;
+
+    // Replays
+    ReplayRecorder recorder;
+    std::string recordPath;
+    Replay playback;
+    ReplayPlayer replayPlayer;
+    bool replayMode;
+
     // System & Settings
     bool gameRunning;
+    bool redrawRequested;     // Idle screens only redraw when something changed
+    bool windowFocused;
     bool showGrid;
+    bool incrementalRender;
+    int boardWidth;
+    int boardHeight;
+    std::string levelName;    // Pack level chosen in settings; empty for the --level map
+
+    // Levels: the --level map and the pack are held in memory, so reset() switches without disk I/O
+    Level baseLevel;
+    LevelPack levelPack;
+    int levelIndex;           // Index into levelPack, -1 for baseLevel
+    const Level* activeLevel; // Layout currently copied into sim
+
+    // Viewport
+    int viewWidth;
+    int viewHeight;
+    int screenWidth;
+    int screenHeight;
+    Camera2D camera;
+
+    // Every player's best lives in one store, loaded once; its file is written by a background
+    // worker so game over never waits on the disk
+    PersistenceWorker persistence;
+    ScoreStore scoreStore;
+    std::string rankText;
+
+    // Profiling
+    FrameProfiler profiler;
+    std::string profilePath;
+    bool showProfiler;
 
     // Resources
-    Font font;
+    FontAtlas fonts;
+    CellBatch fieldBatch;
+
+    // Cached background (grid, obstacles and their glows), rebuilt only when the layout changes
+    static constexpr int MAX_STATIC_LAYER_SIZE = 4096;
+    RenderTexture2D staticLayer;
+    uint32_t staticLayerVersion;
+    bool staticLayerGrid;
+
+    // Incremental body layer: each body cell holds the tick it was entered, a shader derives the fade
+    RenderTexture2D bodyLayer;
+    Shader bodyShader;
+    int bodyTickLoc;
+    int bodyLengthLoc;
+    uint32_t bodyLayerTick;          // Simulation tick the texture was last synced to
+    bool bodyLayerStale;             // Forces a full rewrite, e.g. after a new round starts
+    std::vector<Position> vacatedCells;  // Tails dropped since the last sync; never grows past its reserve
+
+    // Startup loading: scores and levels are read on a thread while the menu is already shown
+    std::thread startupLoader;
+    std::atomic<bool> startupLoaded;  // Set by the loader when it is done
+    bool startupFinished;             // The game thread has joined it and taken over the data
+
+    // Input: turns are queued with their poll time and applied one per tick
+    InputQueue inputQueue;
+    LatencyStats inputLatency;
+    int targetFps;
+    int inputPollRate;                // Polls per second between frames while playing; 0 when off
+    double lastUpdateTime;            // GetTime() of the last update, so extra polls advance the clock too
+
+    // Autopilot: rounds started from the menu's Autopilot entry steer themselves and restart, for demos
+    Autopilot autopilot;
+    bool autopilotMode;
+    float restartTimer;               // Time spent on the current screen, for the autopilot restart
+
+    // Network play (--connect): the match runs on snake_server and is mirrored into match; sim only
+    // holds a copy of its board, so the static layer and viewport work as in a local round
+    NetClient netClient;
+    MatchSim match;
+    bool networkMode;
+    bool turnSent;                    // A turn went out since the last tick arrived
+    uint32_t matchLayoutVersion;      // Layout of match last copied into sim
 
     struct Colors {
         Color background = {15, 15, 25, 255};
@@ -101,40 +236,52 @@ private:
 
     // Core Logic
     void update(float deltaTime);
+    bool stepSimulation();
     void handleInput();
+    void pollInputUntil(double frameEnd);
     void reset();
+    void startRound(bool autopilotRound);
+    void applyLevel();
+    void selectLevel(int index);
     void changeState(GameState newState);
+    void updateMatch();
+    const MatchSnake* getOwnSnake() const;
 
     // Initialization and Data Management
-    void initializeSnake();
-    void generateFood();
-    void loadObstacles(const std::string& filename);
     void loadHighestScores();
-    void savePersonalBest();
-    void saveSessionBestScore();
     void loadLeaderboard();
-    void saveToLeaderboard();
+    void saveScore();
     void loadSettings();
     void saveSettings();
-
-    // Collision and Movement
-    void moveSnake();
-    bool checkCollision();
+    void loadStartupData(std::string levelPath, std::string packPath, int width, int height);
+    bool finishStartup(bool wait);
 
     // Drawing
     void draw();
     void drawGameField();
-    void drawGrid();
+    void drawSnake();
+    void drawMatch();
+    void drawSegment(Vector2 cell, size_t index, size_t length, Color headColor, Color bodyColor);
+    void drawFood(Position food);
+    void drawGrid(int firstX, int firstY, int lastX, int lastY);
+    void drawStaticLayer(int firstX, int firstY, int lastX, int lastY);
+    void updateStaticLayer();
+    void updateBodyLayer();
+    void configureViewport();
+    void updateCamera();
+    bool isCellVisible(Position pos) const;
     void drawUI();
     void drawMenu();
     void drawGameOver();
     void drawLeaderboard();
     void drawSettings();
     void drawPauseOverlay();
+    void drawProfilerOverlay(int x, int y);
     
     // UI Helpers
     void drawProgressBar(int x, int y, int width, int height, float progress, Color color);
-    void drawGlowEffect(Position pos, Color color, float intensity);
+    void drawGlowEffect(Vector2 cell, Color color, float intensity);
+    float getTickAlpha() const;
     void updateAnimations(float deltaTime);
     
     // Input Handlers
@@ -144,6 +291,7 @@ private:
     void handleSettingsInput();
 
     // Utility
+    static bool isIdleState(GameState state);
     int getDifficultyLevel() const;
     float calculateSpeed() const;
 };
@@ -0,0 +1,258 @@
+/**
+ * @file headless.cpp
+ * @brief Implementation of the headless evaluation and verification mode.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "headless.hpp"
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include "rollout.hpp"
+#include "autopilot.hpp"
+#include "replay.hpp"
+#include "level.hpp"
+
+namespace {
+
+const std::string REPLAY_PREFIX = "replay:";
+
+/**
+ * @brief The game's autopilot, one per environment so every lane keeps its own plan.
+ */
+class AutopilotPolicy : public RolloutPolicy {
+public:
+    AutopilotPolicy(size_t envCount, int width, int height) {
+        pilots.reserve(envCount);
+        for (size_t i = 0; i < envCount; ++i) pilots.emplace_back(width, height);
+    }
+
+    void beginEpisode(size_t env, uint64_t seed) override {
+        (void)seed;
+        pilots[env].reset();
+    }
+
+    void act(const BatchSim& batch, Direction* actions) override {
+        const uint8_t* alive = batch.getAlive();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (alive[i]) actions[i] = pilots[i].choose(batch.getEnv(i));
+        }
+    }
+
+private:
+    std::vector<Autopilot> pilots;
+};
+
+struct ReplayOutcome {
+    std::string file;
+    bool loaded = false;
+    ReplayCheck check = { false, 0, 0 };
+    int32_t recordedScore = 0;
+    uint32_t recordedTicks = 0;
+};
+
+// Writes text as a JSON string literal
+void writeString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            const char* hex = "0123456789abcdef";
+            out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Writes min, mean, median, 90th and 99th percentile and max of values as a JSON object
+template <typename T>
+void writeDistribution(std::ostream& out, std::vector<T> values) {
+    if (values.empty()) {
+        out << "null";
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (T value : values) sum += static_cast<double>(value);
+    // Nearest-rank percentile
+    auto percentile = [&values](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+        return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+    };
+    out << "{ \"min\": " << values.front() << ", \"mean\": " << sum / values.size()
+        << ", \"p50\": " << percentile(0.50) << ", \"p90\": " << percentile(0.90)
+        << ", \"p99\": " << percentile(0.99) << ", \"max\": " << values.back() << " }";
+}
+
+// Plays options.episodes episodes with the autopilot or random moves
+int runPolicy(const HeadlessOptions& options, std::ostream& out) {
+    RolloutConfig config;
+    config.episodes = options.episodes;
+    config.threads = options.threads;
+    config.seed = options.seed;
+    if (options.width > 0) config.width = options.width;
+    if (options.height > 0) config.height = options.height;
+
+    // The obstacle list comes from a SnakeSim, which lays text and binary levels out the same way the game does
+    SnakeSim board(config.width, config.height);
+    if (!options.levelPath.empty()) {
+        Level level;
+        if (loadLevel(options.levelPath, board.getWidth(), board.getHeight(), level)) {
+            board.setLevel(level);
+        } else if (options.levelRequired) {
+            std::cerr << "Could not load level: " << options.levelPath << std::endl;
+            return 1;
+        }
+    }
+    config.width = board.getWidth();
+    config.height = board.getHeight();
+    config.obstacles = board.getObstacles();
+
+    PolicyFactory makePolicy;
+    if (options.policy == "autopilot") {
+        makePolicy = [&config](size_t envs) { return std::make_unique<AutopilotPolicy>(envs, config.width, config.height); };
+    } else if (options.policy == "random") {
+        makePolicy = [](size_t envs) { return std::make_unique<RandomPolicy>(envs); };
+    } else {
+        std::cerr << "Unknown policy: " << options.policy << std::endl;
+        return 1;
+    }
+
+    RolloutResult result = runRollouts(config, makePolicy);
+    out << "{\n  \"mode\": \"rollout\",\n  \"policy\": ";
+    writeString(out, options.policy);
+    out << ",\n  \"seed\": " << options.seed
+        << ",\n  \"episodes\": " << config.episodes
+        << ",\n  \"threads\": " << result.threads
+        << ",\n  \"board\": { \"width\": " << config.width << ", \"height\": " << config.height
+        << ", \"obstacles\": " << config.obstacles.size() << " }"
+        << ",\n  \"seconds\": " << result.seconds
+        << ",\n  \"ticks\": " << result.totalTicks
+        << ",\n  \"ticks_per_second\": " << (result.seconds > 0.0 ? result.totalTicks / result.seconds : 0.0)
+        << ",\n  \"episodes_per_second\": " << (result.seconds > 0.0 ? config.episodes / result.seconds : 0.0)
+        << ",\n  \"score\": ";
+    writeDistribution(out, result.scores);
+    out << ",\n  \"length_ticks\": ";
+    writeDistribution(out, result.ticks);
+    out << "\n}\n";
+    return 0;
+}
+
+// Lists the replay at path, or every .rpl file in the directory at path, sorted by name
+std::vector<std::string> listReplays(const std::string& path) {
+    std::vector<std::string> files;
+    std::error_code error;
+    if (!std::filesystem::is_directory(path, error)) {
+        files.push_back(path);
+        return files;
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+        if (entry.is_regular_file(error) && entry.path().extension() == ".rpl") files.push_back(entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// Verifies every replay named by the policy on a pool of threads; fails if any does not verify
+int runReplays(const HeadlessOptions& options, std::ostream& out) {
+    std::vector<std::string> files = listReplays(options.policy.substr(REPLAY_PREFIX.size()));
+    std::vector<ReplayOutcome> outcomes(files.size());
+    unsigned threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, files.size())));
+
+    // Replays take very different times, so workers pull the next file instead of a fixed share
+    std::atomic<size_t> next(0);
+    auto verify = [&]() {
+        Replay replay;
+        for (size_t i = next.fetch_add(1); i < files.size(); i = next.fetch_add(1)) {
+            ReplayOutcome& outcome = outcomes[i];
+            outcome.file = files[i];
+            // A thread has nothing above it to catch with, so a file that still breaks loading counts as unreadable
+            try {
+                outcome.loaded = loadReplay(files[i], replay);
+                if (!outcome.loaded) continue;
+                outcome.check = verifyReplay(replay);
+                outcome.recordedScore = replay.score;
+                outcome.recordedTicks = replay.ticks;
+            } catch (const std::exception&) {
+                outcome.loaded = false;
+                outcome.check = { false, 0, 0 };
+            }
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    try {
+        for (unsigned t = 1; t < threads; ++t) workers.emplace_back(verify);
+    } catch (const std::system_error&) {
+        // Fewer threads than asked for still verify every file, since workers pull from one counter
+    }
+    threads = static_cast<unsigned>(workers.size()) + 1;
+    verify();
+    for (auto& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t ticks = 0;
+    size_t valid = 0;
+    std::vector<int32_t> scores;
+    for (const auto& outcome : outcomes) {
+        ticks += outcome.check.ticks;
+        if (!outcome.check.valid) continue;
+        ++valid;
+        scores.push_back(outcome.check.score);
+    }
+
+    out << "{\n  \"mode\": \"replay\",\n  \"threads\": " << threads
+        << ",\n  \"replays\": " << files.size()
+        << ",\n  \"valid\": " << valid
+        << ",\n  \"invalid\": " << files.size() - valid
+        << ",\n  \"seconds\": " << seconds
+        << ",\n  \"ticks\": " << ticks
+        << ",\n  \"ticks_per_second\": " << (seconds > 0.0 ? ticks / seconds : 0.0)
+        << ",\n  \"replays_per_second\": " << (seconds > 0.0 ? files.size() / seconds : 0.0)
+        << ",\n  \"score\": ";
+    writeDistribution(out, scores);
+    out << ",\n  \"results\": [";
+    for (size_t i = 0; i < outcomes.size(); ++i) {
+        const ReplayOutcome& outcome = outcomes[i];
+        out << (i ? ",\n" : "\n") << "    { \"file\": ";
+        writeString(out, outcome.file);
+        if (!outcome.loaded) {
+            out << ", \"valid\": false, \"error\": \"unreadable\" }";
+            continue;
+        }
+        out << ", \"valid\": " << (outcome.check.valid ? "true" : "false")
+            << ", \"score\": " << outcome.check.score << ", \"ticks\": " << outcome.check.ticks
+            << ", \"recorded_score\": " << outcome.recordedScore << ", \"recorded_ticks\": " << outcome.recordedTicks << " }";
+    }
+    out << (outcomes.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    return !files.empty() && valid == files.size() ? 0 : 1;
+}
+
+} // namespace
+
+// Dispatches on the policy: replay:PATH verifies, anything else plays episodes
+int runHeadless(const HeadlessOptions& options, std::ostream& out) {
+    // Rates and means in plain decimals rather than exponents, which are easier to diff
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    bool replays = options.policy.compare(0, REPLAY_PREFIX.size(), REPLAY_PREFIX) == 0;
+    int code = replays ? runReplays(options, out) : runPolicy(options, out);
+    out.flags(flags);
+    out.precision(precision);
+    return code;
+}
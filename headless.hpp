@@ -0,0 +1,41 @@
+/**
+ * @file headless.hpp
+ * @brief snake_game --headless: bulk evaluation and replay verification without a window.
+ * @details Two modes share the flag. With a playing policy (autopilot or
+ * random) episodes are spread over worker threads by runRollouts; with
+ * replay:PATH every replay in the file or directory is rerun by
+ * verifyReplay on a pool of threads. Either way one JSON object goes to the
+ * output stream: throughput (ticks and episodes per second) and the score
+ * and length distributions, plus a verdict per replay. Nothing here touches
+ * Raylib, so the mode works without a display server, and a replay run
+ * exits with 1 when any replay fails to verify.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+// Largest --episodes and --threads accepted; two results per episode are kept in memory
+constexpr uint64_t MAX_HEADLESS_EPISODES = 100000000;
+constexpr unsigned MAX_HEADLESS_THREADS = 1024;
+
+struct HeadlessOptions {
+    std::string policy = "autopilot";  // "autopilot", "random" or "replay:PATH"
+    uint64_t episodes = 1000;
+    unsigned threads = 0;              // 0 uses every hardware thread
+    uint64_t seed = 1;
+    int width = 0;                     // Board size for rollouts; 0 keeps the default
+    int height = 0;
+    std::string levelPath;             // Obstacle map for rollouts; empty for none
+    bool levelRequired = false;        // Fail instead of playing without obstacles when it cannot be read
+};
+
+// Runs the mode and writes its JSON report to out; returns the process exit code
+int runHeadless(const HeadlessOptions& options, std::ostream& out);
+
+#endif // HEADLESS_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file input_queue.hpp
+ * @brief Fixed-size queue of timestamped turns, consumed one per tick.
+ * @details Turns pressed between two ticks are queued rather than
+ * overwriting each other, so a quick up-then-left both happen, on
+ * consecutive ticks. Each turn is checked against the one queued before
+ * it (or the snake's heading when the queue is empty): repeats and
+ * reversals are dropped at input time, so every queued entry is a move
+ * the simulation will accept. The time stamp lets the game measure how
+ * long a turn waited before it moved the snake.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef INPUT_QUEUE_HPP
+#define INPUT_QUEUE_HPP
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "snake_sim.hpp"
+
+struct InputEvent {
+    Direction direction;
+    double time;  // Seconds, on the clock the game polls input with
+};
+
+class InputQueue {
+public:
+    static constexpr size_t CAPACITY = 4;  // Turns beyond this are dropped rather than delayed further
+
+    // Queues a turn unless it repeats or reverses the previous one; false if dropped
+    bool push(Direction direction, double time, Direction heading) {
+        Direction previous = count == 0 ? heading : events[(head + count - 1) % CAPACITY].direction;
+        if (count == CAPACITY || direction == previous || isReverse(direction, previous)) return false;
+        events[(head + count) % CAPACITY] = { direction, time };
+        ++count;
+        return true;
+    }
+
+    bool pop(InputEvent& event) {
+        if (count == 0) return false;
+        event = events[head];
+        head = (head + 1) % CAPACITY;
+        --count;
+        return true;
+    }
+
+    void clear() { head = 0; count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    static bool isReverse(Direction a, Direction b) {
+        return (a == Direction::UP && b == Direction::DOWN) || (a == Direction::DOWN && b == Direction::UP) ||
+               (a == Direction::LEFT && b == Direction::RIGHT) || (a == Direction::RIGHT && b == Direction::LEFT);
+    }
+
+private:
+    std::array<InputEvent, CAPACITY> events{};
+    size_t head = 0;
+    size_t count = 0;
+};
+
+// Running input-to-move latency: from the poll that saw a key to the tick that applied it
+struct LatencyStats {
+    uint64_t count = 0;
+    double totalSeconds = 0.0;
+    double maxSeconds = 0.0;
+
+    void add(double seconds) {
+        ++count;
+        totalSeconds += seconds;
+        maxSeconds = std::max(maxSeconds, seconds);
+    }
+    double averageMs() const { return count == 0 ? 0.0 : totalSeconds * 1000.0 / count; }
+    double maxMs() const { return maxSeconds * 1000.0; }
+};
+
+#endif // INPUT_QUEUE_HPP
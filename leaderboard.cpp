@@ -0,0 +1,51 @@
+/**
+ * @file leaderboard.cpp
+ * @brief Implementation of the legacy text score files.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "leaderboard.hpp"
+#include "persistence.hpp"
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <algorithm>
+
+// Loads the best score per player, sorted best first
+std::vector<ScoreEntry> readLeaderboard(const std::string& filename) {
+    std::vector<ScoreEntry> leaderboard;
+    std::map<std::string, int> bestScores;
+
+    std::ifstream file(filename);
+    if (file.is_open()) {
+        std::string name;
+        int scoreVal;
+        while (file >> name >> scoreVal) {
+            if (bestScores.find(name) == bestScores.end() || scoreVal > bestScores[name]) {
+                bestScores[name] = scoreVal;
+            }
+        }
+
+        for (const auto& pair : bestScores) {
+            leaderboard.push_back({pair.first, pair.second});
+        }
+
+        std::sort(leaderboard.begin(), leaderboard.end());
+    }
+    return leaderboard;
+}
+
+// Formats the leaderboard as "name score" lines
+std::string formatLeaderboard(const std::vector<ScoreEntry>& leaderboard) {
+    std::ostringstream out;
+    for (const auto& entry : leaderboard) {
+        out << entry.name << " " << entry.score << "\n";
+    }
+    return out.str();
+}
+
+// Writes the leaderboard file
+bool writeLeaderboard(const std::vector<ScoreEntry>& leaderboard, const std::string& filename) {
+    return writeFileAtomic(filename, formatLeaderboard(leaderboard));
+}
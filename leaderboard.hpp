@@ -0,0 +1,33 @@
+/**
+ * @file leaderboard.hpp
+ * @brief Score entries and the legacy text score files.
+ * @details Before scores.db the game kept two text files of "name score"
+ * lines: user_scores.txt with personal bests and scores.txt with the
+ * leaderboard. They are only read now, when ScoreStore imports them on
+ * first start; the writer remains for the benchmark's fixture files.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef LEADERBOARD_HPP
+#define LEADERBOARD_HPP
+
+#include <vector>
+#include <string>
+
+struct ScoreEntry {
+    std::string name;
+    int score;
+    bool operator<(const ScoreEntry& other) const {
+        return score > other.score;
+    }
+};
+
+// Reads the best score per player, sorted best first
+std::vector<ScoreEntry> readLeaderboard(const std::string& filename);
+
+// Formats and writes "name score" lines
+std::string formatLeaderboard(const std::vector<ScoreEntry>& leaderboard);
+bool writeLeaderboard(const std::vector<ScoreEntry>& leaderboard, const std::string& filename);
+
+#endif // LEADERBOARD_HPP
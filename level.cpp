@@ -0,0 +1,192 @@
+/**
+ * @file level.cpp
+ * @brief Implementation of the level file formats.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "level.hpp"
+#include "snake_sim.hpp"
+#include "persistence.hpp"
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'S', 'N', 'K', 'L'};
+const uint8_t VERSION = 1;
+const size_t HEADER_SIZE = 16;
+
+// Read-only view of a whole file, memory-mapped where the platform supports it
+class FileView {
+public:
+    explicit FileView(const std::string& path) : bytes(nullptr), length(0), opened(false) {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return;
+        buffer.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
+        opened = true;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0) {
+            length = static_cast<size_t>(info.st_size);
+            opened = true;
+            if (length > 0) {
+                void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    opened = false;
+                    length = 0;
+                } else {
+                    bytes = static_cast<const char*>(mapped);
+                }
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~FileView() {
+#ifndef _WIN32
+        if (bytes) munmap(const_cast<char*>(bytes), length);
+#endif
+    }
+
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes;
+    size_t length;
+    bool opened;
+#ifdef _WIN32
+    std::string buffer;
+#endif
+};
+
+uint32_t readLE(const char* data, int byteCount) {
+    uint32_t value = 0;
+    for (int i = 0; i < byteCount; ++i) value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    return value;
+}
+
+void writeLE(std::string& out, uint64_t value, int byteCount) {
+    for (int i = 0; i < byteCount; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+// Copies the bitmap words; on little-endian hosts the file layout is the memory layout
+void copyWords(const char* data, Level& level) {
+    uint64_t* words = level.cells.data();
+    size_t wordCount = level.cells.wordCount();
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(words, data, wordCount * sizeof(uint64_t));
+#else
+    for (size_t w = 0; w < wordCount; ++w) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(static_cast<uint8_t>(data[w * 8 + i])) << (8 * i);
+        words[w] = value;
+    }
+#endif
+    // Bits past the last cell would otherwise read as obstacles off the board
+    size_t tailBits = level.cells.size() % 64;
+    if (tailBits != 0) words[wordCount - 1] &= (uint64_t(1) << tailBits) - 1;
+}
+
+size_t countBits(const OccupancyGrid& cells) {
+    size_t count = 0;
+    const uint64_t* words = cells.data();
+    for (size_t w = 0; w < cells.wordCount(); ++w) count += static_cast<size_t>(__builtin_popcountll(words[w]));
+    return count;
+}
+
+bool parseBinary(const FileView& view, Level& level) {
+    const char* data = view.data();
+    if (view.size() < HEADER_SIZE || static_cast<uint8_t>(data[4]) != VERSION) return false;
+    int width = static_cast<int>(readLE(data + 8, 2));
+    int height = static_cast<int>(readLE(data + 10, 2));
+    if (width < SnakeSim::MIN_GRID_SIZE || width > SnakeSim::MAX_GRID_SIZE ||
+        height < SnakeSim::MIN_GRID_SIZE || height > SnakeSim::MAX_GRID_SIZE) return false;
+
+    size_t cellCount = static_cast<size_t>(width) * height;
+    size_t wordCount = (cellCount + 63) / 64;
+    if (view.size() != HEADER_SIZE + wordCount * sizeof(uint64_t)) return false;
+
+    level.width = width;
+    level.height = height;
+    if (level.cells.size() != cellCount) level.cells = OccupancyGrid(cellCount);
+    copyWords(data + HEADER_SIZE, level);
+    level.count = countBits(level.cells);
+    return true;
+}
+
+// Scans "x y" pairs in place; cells outside the board are skipped
+bool parseText(const FileView& view, int boardWidth, int boardHeight, Level& level) {
+    size_t cellCount = static_cast<size_t>(boardWidth) * boardHeight;
+    level.width = boardWidth;
+    level.height = boardHeight;
+    if (level.cells.size() != cellCount) level.cells = OccupancyGrid(cellCount);
+    else level.cells.clearAll();
+
+    const char* pos = view.data();
+    const char* end = pos + view.size();
+    auto nextInt = [&](int& value) {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) ++pos;
+        auto result = std::from_chars(pos, end, value);
+        if (result.ec != std::errc()) return false;
+        pos = result.ptr;
+        return true;
+    };
+
+    int x, y;
+    while (nextInt(x) && nextInt(y)) {
+        if (x >= 0 && x < boardWidth && y >= 0 && y < boardHeight) {
+            level.cells.set(static_cast<size_t>(y) * boardWidth + x);
+        }
+    }
+    level.count = countBits(level.cells);
+    return true;
+}
+
+} // namespace
+
+// Detects the format from the magic and fills the level; false if the file is missing or invalid
+bool loadLevel(const std::string& filename, int boardWidth, int boardHeight, Level& level) {
+    FileView view(filename);
+    if (!view.isOpen()) return false;
+    if (view.size() >= sizeof(MAGIC) && std::memcmp(view.data(), MAGIC, sizeof(MAGIC)) == 0) {
+        return parseBinary(view, level);
+    }
+    return parseText(view, boardWidth, boardHeight, level);
+}
+
+// Serializes the header and bitmap, then writes them atomically
+bool saveLevel(const Level& level, const std::string& filename) {
+    std::string bytes(MAGIC, sizeof(MAGIC));
+    bytes.push_back(static_cast<char>(VERSION));
+    bytes.append(3, '\0');
+    writeLE(bytes, static_cast<uint64_t>(level.width), 2);
+    writeLE(bytes, static_cast<uint64_t>(level.height), 2);
+    writeLE(bytes, static_cast<uint64_t>(level.count), 4);
+    const uint64_t* words = level.cells.data();
+    bytes.reserve(bytes.size() + level.cells.wordCount() * sizeof(uint64_t));
+    for (size_t w = 0; w < level.cells.wordCount(); ++w) writeLE(bytes, words[w], 8);
+    return writeFileAtomic(filename, bytes);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file level.hpp
+ * @brief Obstacle maps on disk: a binary bitmap format and the old text list.
+ * @details A binary level (".lvl") is a 16-byte header followed by the
+ * obstacle bitmap in exactly the layout of OccupancyGrid: one bit per cell,
+ * row-major, packed into little-endian 64-bit words. The file is mapped into
+ * memory and the words are copied straight into the grid, so loading costs
+ * one copy regardless of how many obstacles the map holds.
+ *
+ *   offset  size  field
+ *   0       4     magic "SNKL"
+ *   4       1     format version (1)
+ *   5       3     reserved, zero
+ *   8       2     board width in cells
+ *   10      2     board height in cells
+ *   12      4     number of obstacle cells
+ *   16      8*n   bitmap words, n = (width * height + 63) / 64
+ *
+ * Files without the magic are read as the original text format of
+ * "x y" pairs, laid onto a board of the caller's size.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef LEVEL_HPP
+#define LEVEL_HPP
+
+#include <string>
+#include <cstddef>
+#include "occupancy_grid.hpp"
+
+struct Level {
+    int width = 0;
+    int height = 0;
+    OccupancyGrid cells{0};  // Obstacle bits, row-major over width * height
+    size_t count = 0;        // Number of set bits
+};
+
+// Reads a binary or text level; text levels take the given board size
+bool loadLevel(const std::string& filename, int boardWidth, int boardHeight, Level& level);
+
+// Writes a level in the binary format; returns false on failure
+bool saveLevel(const Level& level, const std::string& filename);
+
+#endif // LEVEL_HPP
@@ -0,0 +1,76 @@
+/**
+ * @file level_pack.cpp
+ * @brief Implementation of the background-loaded level pack.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "level_pack.hpp"
+#include <filesystem>
+#include <algorithm>
+#include <system_error>
+
+// Constructor: An empty pack; open() fills it
+LevelPack::LevelPack() : boardWidth(0), boardHeight(0), stopping(false) {}
+
+// Destructor: Lets the loader finish its current file and joins it
+LevelPack::~LevelPack() {
+    stopping = true;
+    if (loader.joinable()) loader.join();
+}
+
+// Lists the level files and starts the loader; a missing directory gives an empty pack
+void LevelPack::open(const std::string& directory, int width, int height) {
+    stopping = true;
+    if (loader.joinable()) loader.join();
+    stopping = false;
+    entries.clear();
+    boardWidth = width;
+    boardHeight = height;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        const auto& path = it->path();
+        if (!it->is_regular_file(error) || (path.extension() != ".lvl" && path.extension() != ".txt")) continue;
+        auto entry = std::make_unique<Entry>();
+        entry->name = path.stem().string();
+        entry->path = path.string();
+        entries.push_back(std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a->name < b->name; });
+
+    if (!entries.empty()) loader = std::thread(&LevelPack::run, this);
+}
+
+// Joins the loader, which exits once every entry is read
+void LevelPack::wait() {
+    if (loader.joinable()) loader.join();
+}
+
+// Returns a loaded level; the acquire pairs with the loader's release
+const Level* LevelPack::get(size_t index) const {
+    const Entry& entry = *entries[index];
+    return entry.state.load(std::memory_order_acquire) == READY ? &entry.level : nullptr;
+}
+
+// Returns true when the level's file could not be read
+bool LevelPack::isFailed(size_t index) const {
+    return entries[index]->state.load(std::memory_order_acquire) == FAILED;
+}
+
+// Looks a level up by name
+int LevelPack::find(const std::string& name) const {
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i]->name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// Loader thread: reads the levels in index order
+void LevelPack::run() {
+    for (auto& entry : entries) {
+        if (stopping) return;
+        bool ok = loadLevel(entry->path, boardWidth, boardHeight, entry->level);
+        entry->state.store(ok ? READY : FAILED, std::memory_order_release);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file level_pack.hpp
+ * @brief A directory of levels, loaded in the background and kept in memory.
+ * @details open() lists the .lvl and .txt files of a directory, sorted by
+ * name, and hands them to a loader thread that reads each into its own
+ * Level. The index is fixed once open() returns, so names can be shown right
+ * away; a level becomes available through get() as soon as its file has been
+ * read. Switching to a loaded level is then a bitmap copy into SnakeSim with
+ * no disk access, and no allocation when it has the current board size.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef LEVEL_PACK_HPP
+#define LEVEL_PACK_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include "level.hpp"
+
+class LevelPack {
+public:
+    LevelPack();
+    ~LevelPack();  // Stops the loader after the file it is reading
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    // Indexes a directory and starts loading it; text levels take the given board size
+    void open(const std::string& directory, int boardWidth, int boardHeight);
+    void wait();  // Blocks until every level has been read
+
+    size_t size() const { return entries.size(); }
+    const std::string& getName(size_t index) const { return entries[index]->name; }
+    const Level* get(size_t index) const;  // nullptr while loading or if the file is invalid
+    bool isFailed(size_t index) const;
+    int find(const std::string& name) const;  // -1 if no level has this name
+
+private:
+    enum EntryState { PENDING, READY, FAILED };
+
+    struct Entry {
+        std::string name;  // File name without the extension
+        std::string path;
+        Level level;
+        std::atomic<int> state{PENDING};  // Published by the loader after level is filled
+    };
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    int boardWidth;
+    int boardHeight;
+    std::atomic<bool> stopping;
+    std::thread loader;
+
+    void run();
+};
+
+#endif // LEVEL_PACK_HPP
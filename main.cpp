@@ -7,15 +7,202 @@
 
 #include <iostream>
 #include <string>
+#include <cstdlib>
+#include <random>
 #include "game.hpp"
+#include "headless.hpp"
+
+/**
+ * @brief Prints the supported command-line options.
+ * @param program The name the program was invoked with.
+ */
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --width N     Board width in cells (default from settings.txt)\n"
+              << "  --height N    Board height in cells (default from settings.txt)\n"
+              << "  --seed N      Fixed random seed, making food placement reproducible\n"
+              << "  --record FILE Save a replay of each finished round to FILE\n"
+              << "  --replay FILE Play back a recorded replay\n"
+              << "  --fast        With --replay: verify the replay headless at full speed\n"
+              << "  --fps N       Render frame cap, 0 for uncapped (default 60)\n"
+              << "  --vsync       Synchronise rendering with the display\n"
+              << "  --input-rate N Poll input N times per second while playing (frame cap required, not with --vsync)\n"
+              << "  --profile FILE Export per-frame timings on exit (CSV, or JSON for .json)\n"
+              << "  --bench-render Print renderer frame rates at several board sizes and exit\n"
+              << "  --level FILE  Obstacle map, binary or text (default obstacles.txt)\n"
+              << "  --convert-level FILE Write --level as a binary level to FILE and exit\n"
+              << "  --connect HOST:PORT Join the match hosted by snake_server at HOST:PORT\n"
+              << "  --headless    Run without a window and print JSON results, see --policy\n"
+              << "  --policy P    With --headless: autopilot, random, or replay:PATH to verify a replay\n"
+              << "                file or every .rpl file in a directory (default autopilot)\n"
+              << "  --episodes N  With --headless: episodes to play, at most 100000000 (default 1000)\n"
+              << "  --threads N   With --headless: worker threads, at most 1024, 0 for every core (default 0)\n";
+}
+
+/**
+ * @brief Parses command-line options into a game configuration.
+ * @param argc Argument count from main.
+ * @param argv Argument vector from main.
+ * @param config The configuration to fill in.
+ * @return true if every argument was recognised, false otherwise.
+ */
+static bool parseArguments(int argc, char* argv[], GameConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--width" && hasValue) {
+            config.gridWidth = std::atoi(argv[++i]);
+        } else if (arg == "--height" && hasValue) {
+            config.gridHeight = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            config.fixedSeed = true;
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--record" && hasValue) {
+            config.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            config.replayPath = argv[++i];
+        } else if (arg == "--fast") {
+            config.fastReplay = true;
+        } else if (arg == "--fps" && hasValue) {
+            config.targetFps = std::atoi(argv[++i]);
+        } else if (arg == "--vsync") {
+            config.vsync = true;
+        } else if (arg == "--input-rate" && hasValue) {
+            config.inputRate = std::atoi(argv[++i]);
+        } else if (arg == "--profile" && hasValue) {
+            config.profilePath = argv[++i];
+        } else if (arg == "--bench-render") {
+            config.renderBenchmark = true;
+        } else if (arg == "--level" && hasValue) {
+            config.levelPath = argv[++i];
+        } else if (arg == "--convert-level" && hasValue) {
+            config.convertLevelPath = argv[++i];
+        } else if (arg == "--connect" && hasValue) {
+            config.connectAddress = argv[++i];
+        } else if (arg == "--headless") {
+            config.headless = true;
+        } else if (arg == "--policy" && hasValue) {
+            config.policy = argv[++i];
+        } else if (arg == "--episodes" && hasValue) {
+            config.episodes = std::strtoull(argv[++i], nullptr, 10);
+            if (config.episodes > MAX_HEADLESS_EPISODES) return false;
+        } else if (arg == "--threads" && hasValue) {
+            unsigned long threads = std::strtoul(argv[++i], nullptr, 10);
+            if (threads > MAX_HEADLESS_THREADS) return false;
+            config.threads = static_cast<unsigned>(threads);
+        } else {
+            return false;
+        }
+    }
+    if (!config.connectAddress.empty() && !config.replayPath.empty()) return false;
+    return !config.fastReplay || !config.replayPath.empty();
+}
+
+/**
+ * @brief Verifies a replay without opening a window.
+ * @param filename The replay file to check.
+ * @return 0 if the replay reproduces its recorded score, 1 otherwise.
+ */
+static int runFastReplay(const std::string& filename) {
+    Replay replay;
+    if (!loadReplay(filename, replay)) {
+        std::cerr << "Could not load replay: " << filename << std::endl;
+        return 1;
+    }
+    ReplayCheck check = verifyReplay(replay);
+    std::cout << (check.valid ? "Replay verified: " : "Replay mismatch: ")
+              << "score " << check.score << " in " << check.ticks << " ticks"
+              << " (recorded " << replay.score << " in " << replay.ticks << ")" << std::endl;
+    return check.valid ? 0 : 1;
+}
+
+/**
+ * @brief Converts a level to the binary format without opening a window.
+ * @details Text levels are laid onto a board of --width by --height cells,
+ * or the default board size when those are not given.
+ * @param config The configuration naming the input and output files.
+ * @return 0 on success, 1 if the level could not be read or written.
+ */
+static int runConvertLevel(const GameConfig& config) {
+    int width = config.gridWidth > 0 ? config.gridWidth : SnakeSim::DEFAULT_WIDTH;
+    int height = config.gridHeight > 0 ? config.gridHeight : SnakeSim::DEFAULT_HEIGHT;
+    Level level;
+    if (!loadLevel(config.levelPath, width, height, level)) {
+        std::cerr << "Could not load level: " << config.levelPath << std::endl;
+        return 1;
+    }
+    if (!saveLevel(level, config.convertLevelPath)) {
+        std::cerr << "Could not write level: " << config.convertLevelPath << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << level.width << "x" << level.height << " level with "
+              << level.count << " obstacles to " << config.convertLevelPath << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Runs the headless mode without initialising Raylib or asking for a name.
+ * @details Rollouts use --seed, or a fresh random seed that the JSON output
+ * reports so the run can be repeated, on the --width by --height board with
+ * the --level obstacles.
+ * @param config The configuration holding the headless options.
+ * @return The exit code of runHeadless().
+ */
+static int runHeadlessMode(const GameConfig& config) {
+    HeadlessOptions options;
+    options.policy = config.policy;
+    options.episodes = config.episodes;
+    options.threads = config.threads;
+    if (config.fixedSeed) {
+        options.seed = config.seed;
+    } else {
+        std::random_device device;
+        options.seed = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    options.width = config.gridWidth;
+    options.height = config.gridHeight;
+    options.levelPath = config.levelPath;
+    options.levelRequired = config.levelPath != GameConfig().levelPath;  // The default map is optional
+    return runHeadless(options, std::cout);
+}
 
 /**
  * @brief The main function, serving as the program's entry point.
- * @details It prompts the user for their name, creates a Game instance,
- * and starts the main game loop.
+ * @details It parses command-line options, prompts the user for their name,
+ * creates a Game instance, and starts the main game loop.
  * @return 0 on successful execution, 1 on error.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    GameConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (config.fastReplay) {
+        return runFastReplay(config.replayPath);
+    }
+    if (!config.convertLevelPath.empty()) {
+        return runConvertLevel(config);
+    }
+    if (config.headless) {
+        try {
+            return runHeadlessMode(config);
+        } catch (const std::exception& e) {
+            std::cerr << "An unhandled exception occurred: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (config.renderBenchmark) {
+        try {
+            Game game("bench", config);
+            game.runRenderBenchmark();
+        } catch (const std::exception& e) {
+            std::cerr << "An unhandled exception occurred: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     std::string playerName;
     
     std::cout << "Welcome to Snake Game - Modern Edition!" << std::endl;
@@ -27,7 +214,7 @@ int main() {
     }
     
     try {
-        Game game(playerName);
+        Game game(playerName, config);
         game.run();
     } catch (const std::exception& e) {
         std::cerr << "An unhandled exception occurred: " << e.what() << std::endl;
@@ -0,0 +1,343 @@
+/**
+ * @file match_sim.cpp
+ * @brief Implementation of the shared multiplayer board.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "match_sim.hpp"
+#include <algorithm>
+
+namespace {
+
+const Position NO_FOOD = { -1, -1 };
+
+bool isReverse(Direction a, Direction b) {
+    return (a == Direction::UP && b == Direction::DOWN) || (a == Direction::DOWN && b == Direction::UP) ||
+           (a == Direction::LEFT && b == Direction::RIGHT) || (a == Direction::RIGHT && b == Direction::LEFT);
+}
+
+// The heading that leads from one cell to the next
+Direction headingBetween(Position from, Position to) {
+    if (to.x != from.x) return to.x < from.x ? Direction::LEFT : Direction::RIGHT;
+    return to.y < from.y ? Direction::UP : Direction::DOWN;
+}
+
+Position moved(Position pos, Direction direction) {
+    switch (direction) {
+        case Direction::UP:    pos.y--; break;
+        case Direction::DOWN:  pos.y++; break;
+        case Direction::LEFT:  pos.x--; break;
+        case Direction::RIGHT: pos.x++; break;
+    }
+    return pos;
+}
+
+} // namespace
+
+// Constructor: Creates an empty board with foodCount food slots
+MatchSim::MatchSim(int width, int height, size_t foodCount)
+    : width(0), height(0), foodCount(foodCount), occupied(0), foodCells(0), freeCells(0),
+      playerCount(0), ticks(0), layoutVersion(0) {
+    resize(width, height);
+}
+
+// Reallocates every per-cell structure and empties the board
+void MatchSim::resize(int newWidth, int newHeight) {
+    width = std::max(SnakeSim::MIN_GRID_SIZE, std::min(SnakeSim::MAX_GRID_SIZE, newWidth));
+    height = std::max(SnakeSim::MIN_GRID_SIZE, std::min(SnakeSim::MAX_GRID_SIZE, newHeight));
+    size_t cellCount = static_cast<size_t>(width) * height;
+
+    occupied = OccupancyGrid(cellCount);
+    foodCells = OccupancyGrid(cellCount);
+    freeCells = FreeCellSet(cellCount);
+    for (uint32_t cell = 0; cell < cellCount; ++cell) freeCells.insert(cell);
+    headClaims.assign(cellCount, 0);
+    headOwners.assign(cellCount, 0);
+
+    obstacles.clear();
+    foods.assign(foodCount, NO_FOOD);
+    snakes.clear();
+    playerCount = 0;
+    ticks = 0;
+    ++layoutVersion;
+}
+
+// Empties the board at the level's size and marks its obstacles
+void MatchSim::setLevel(const Level& level) {
+    resize(level.width, level.height);
+    for (int16_t y = 0; y < height; ++y) {
+        for (int16_t x = 0; x < width; ++x) {
+            Position pos = { x, y };
+            if (!level.cells.test(cellIndex(pos))) continue;
+            obstacles.push_back(pos);
+            occupy(pos);
+        }
+    }
+}
+
+// Empties the board and marks the given obstacles; cells off the board are ignored
+void MatchSim::setObstacles(const std::vector<Position>& layout) {
+    resize(width, height);
+    for (const auto& pos : layout) {
+        if (!isInside(pos) || occupied.test(cellIndex(pos))) continue;
+        obstacles.push_back(pos);
+        occupy(pos);
+    }
+}
+
+// Takes the lowest free id; the snake enters the board on the next tick
+int MatchSim::addSnake() {
+    size_t id = 0;
+    while (id < snakes.size() && snakes[id].joined) ++id;
+    if (id == MAX_SNAKES) return -1;
+    if (id == snakes.size()) snakes.emplace_back();
+
+    MatchSnake& snake = snakes[id];
+    snake = MatchSnake();
+    snake.joined = true;
+    snake.respawnAt = ticks + 1;
+    ++playerCount;
+    return static_cast<int>(id);
+}
+
+// Takes a snake off the board for good; the LEFT event goes out with the next tick
+void MatchSim::removeSnake(uint16_t id, MatchDelta& delta) {
+    if (id >= snakes.size() || !snakes[id].joined) return;
+    MatchSnake& snake = snakes[id];
+    clearBody(snake);
+    snake.joined = false;
+    --playerCount;
+    delta.events.push_back({ MatchEventType::LEFT, id, NO_FOOD });
+}
+
+// Records a turn; it is checked against the heading when the next tick runs
+void MatchSim::setDirection(uint16_t id, Direction direction) {
+    if (id < snakes.size() && snakes[id].joined) snakes[id].requested = direction;
+}
+
+// Advances every snake one cell and appends the resulting events to delta
+void MatchSim::step(MatchDelta& delta) {
+    delta.tick = ++ticks;
+
+    // Turn, and find where every head goes
+    for (auto& snake : snakes) {
+        if (!snake.alive) continue;
+        if (!isReverse(snake.direction, snake.requested)) snake.direction = snake.requested;
+        snake.next = moved(snake.body.front(), snake.direction);
+        snake.eats = isInside(snake.next) && foodCells.test(cellIndex(snake.next));
+        snake.dies = false;
+    }
+
+    // Tails that do not grow move away first, so a head may enter the cell a tail just left
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        MatchSnake& snake = snakes[id];
+        if (!snake.alive || snake.eats) continue;
+        vacate(snake.body.back());
+        snake.body.pop_back();
+        delta.events.push_back({ MatchEventType::TAIL, static_cast<uint16_t>(id), NO_FOOD });
+    }
+
+    // Walls, obstacles and bodies kill; two heads entering one cell kill both
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        MatchSnake& snake = snakes[id];
+        if (!snake.alive) continue;
+        if (!isInside(snake.next) || occupied.test(cellIndex(snake.next))) {
+            snake.dies = true;
+            continue;
+        }
+        size_t cell = cellIndex(snake.next);
+        if (headClaims[cell] == ticks) {
+            snake.dies = true;
+            snakes[headOwners[cell]].dies = true;
+        } else {
+            headClaims[cell] = ticks;
+            headOwners[cell] = static_cast<uint16_t>(id);
+        }
+    }
+
+    // Survivors move in; the dead leave the board until they respawn
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        MatchSnake& snake = snakes[id];
+        if (!snake.alive) continue;
+        if (snake.dies) {
+            clearBody(snake);
+            snake.respawnAt = ticks + RESPAWN_TICKS;
+            delta.events.push_back({ MatchEventType::DIED, static_cast<uint16_t>(id), NO_FOOD });
+            continue;
+        }
+        snake.body.push_front(snake.next);
+        occupy(snake.next);
+        delta.events.push_back({ MatchEventType::HEAD, static_cast<uint16_t>(id), snake.next });
+    }
+
+    // Eaten food now lies under a head; it and any slot that found no cell earlier get a new one
+    for (size_t slot = 0; slot < foods.size(); ++slot) {
+        if (foods[slot].x < 0 || occupied.test(cellIndex(foods[slot]))) respawnFood(slot, delta);
+    }
+
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        MatchSnake& snake = snakes[id];
+        if (!snake.joined || snake.alive || ticks < snake.respawnAt) continue;
+        if (spawnSnake(static_cast<uint16_t>(id))) {
+            delta.events.push_back({ MatchEventType::SPAWN, static_cast<uint16_t>(id), snake.body.front() });
+        }
+    }
+}
+
+// Describes the current board for a client that starts from an empty one with the same obstacles
+void MatchSim::snapshot(MatchDelta& delta) const {
+    delta.tick = ticks;
+    for (size_t slot = 0; slot < foods.size(); ++slot) {
+        delta.events.push_back({ MatchEventType::FOOD, static_cast<uint16_t>(slot), foods[slot] });
+    }
+    for (size_t id = 0; id < snakes.size(); ++id) {
+        if (!snakes[id].joined) continue;
+        // Snakes waiting to spawn are announced as dead, so the client counts every player
+        if (!snakes[id].alive) {
+            delta.events.push_back({ MatchEventType::DIED, static_cast<uint16_t>(id), { 0, 0 } });
+            continue;
+        }
+        for (const auto& pos : snakes[id].body) {
+            delta.events.push_back({ MatchEventType::SEGMENT, static_cast<uint16_t>(id), pos });
+        }
+    }
+}
+
+// Replays events received from the server; the rules are not rerun, only checked for fit
+bool MatchSim::apply(const MatchDelta& delta) {
+    for (const auto& event : delta.events) {
+        if (event.id >= MAX_SNAKES) return false;
+        bool placed = event.type == MatchEventType::HEAD || event.type == MatchEventType::SPAWN ||
+                      event.type == MatchEventType::SEGMENT;
+        if (placed && !isInside(event.pos)) return false;
+
+        if (event.type == MatchEventType::FOOD) {
+            if (event.pos.x >= 0 && !isInside(event.pos)) return false;
+            if (event.id >= foods.size()) foods.resize(event.id + 1, NO_FOOD);
+            placeFood(event.id, event.pos);
+            continue;
+        }
+
+        if (event.id >= snakes.size()) snakes.resize(event.id + 1);
+        MatchSnake& snake = snakes[event.id];
+        if ((placed || event.type == MatchEventType::DIED) && !snake.joined) {
+            snake.joined = true;
+            ++playerCount;
+        }
+        switch (event.type) {
+            case MatchEventType::HEAD:
+                if (!snake.alive) return false;
+                snake.direction = headingBetween(snake.body.front(), event.pos);
+                snake.body.push_front(event.pos);
+                occupy(event.pos);
+                break;
+            case MatchEventType::TAIL:
+                if (snake.body.empty()) return false;
+                vacate(snake.body.back());
+                snake.body.pop_back();
+                break;
+            case MatchEventType::DIED:
+                clearBody(snake);
+                break;
+            case MatchEventType::LEFT:
+                clearBody(snake);
+                if (snake.joined) --playerCount;
+                snake.joined = false;
+                break;
+            case MatchEventType::SPAWN:
+                if (snake.alive || event.pos.y + 2 >= height) return false;
+                for (int16_t dy = 0; dy < 3; ++dy) {
+                    Position pos = { event.pos.x, static_cast<int16_t>(event.pos.y + dy) };
+                    snake.body.push_back(pos);
+                    occupy(pos);
+                }
+                snake.direction = Direction::UP;
+                snake.alive = true;
+                break;
+            case MatchEventType::SEGMENT:
+                snake.body.push_back(event.pos);
+                occupy(event.pos);
+                if (snake.body.size() == 2) snake.direction = headingBetween(snake.body[1], snake.body[0]);
+                snake.alive = true;
+                break;
+            default:
+                return false;
+        }
+    }
+    ticks = delta.tick;
+    return true;
+}
+
+// Marks a cell as taken by an obstacle or a snake
+void MatchSim::occupy(Position pos) {
+    size_t cell = cellIndex(pos);
+    occupied.set(cell);
+    freeCells.erase(static_cast<uint32_t>(cell));
+}
+
+// Frees a cell a snake left; it stays out of the free set while food lies on it
+void MatchSim::vacate(Position pos) {
+    size_t cell = cellIndex(pos);
+    occupied.clear(cell);
+    if (!foodCells.test(cell)) freeCells.insert(static_cast<uint32_t>(cell));
+}
+
+// Takes every segment of a snake off the board
+void MatchSim::clearBody(MatchSnake& snake) {
+    for (const auto& pos : snake.body) vacate(pos);
+    snake.body.clear();
+    snake.alive = false;
+}
+
+// Places a new snake heading up on a random free column of three cells with a free cell ahead
+bool MatchSim::spawnSnake(uint16_t id) {
+    for (int attempt = 0; attempt < SPAWN_ATTEMPTS && !freeCells.empty(); ++attempt) {
+        uint32_t cell = freeCells.at(rng.nextBelow(static_cast<uint32_t>(freeCells.size())));
+        int16_t x = static_cast<int16_t>(cell % width);
+        int16_t y = static_cast<int16_t>(cell / width);
+        if (y < 1 || y + 2 >= height) continue;
+        if (!freeCells.contains(cell - width) || !freeCells.contains(cell + width) ||
+            !freeCells.contains(cell + 2 * width)) continue;
+
+        MatchSnake& snake = snakes[id];
+        for (int16_t dy = 0; dy < 3; ++dy) {
+            Position pos = { x, static_cast<int16_t>(y + dy) };
+            snake.body.push_back(pos);
+            occupy(pos);
+        }
+        snake.direction = Direction::UP;
+        snake.requested = Direction::UP;
+        snake.alive = true;
+        return true;
+    }
+    return false;
+}
+
+// Moves a food slot, keeping the food grid and the free set in step
+void MatchSim::placeFood(size_t slot, Position pos) {
+    Position old = foods[slot];
+    if (old.x >= 0) {
+        size_t cell = cellIndex(old);
+        foodCells.clear(cell);
+        if (!occupied.test(cell)) freeCells.insert(static_cast<uint32_t>(cell));
+    }
+    foods[slot] = pos;
+    if (pos.x >= 0) {
+        size_t cell = cellIndex(pos);
+        foodCells.set(cell);
+        freeCells.erase(static_cast<uint32_t>(cell));
+    }
+}
+
+// Moves a food slot to a random free cell, or empties it while the board is full
+void MatchSim::respawnFood(size_t slot, MatchDelta& delta) {
+    Position pos = NO_FOOD;
+    if (!freeCells.empty()) {
+        uint32_t cell = freeCells.at(rng.nextBelow(static_cast<uint32_t>(freeCells.size())));
+        pos = { static_cast<int16_t>(cell % width), static_cast<int16_t>(cell / width) };
+    }
+    if (pos == foods[slot]) return;
+    placeFood(slot, pos);
+    delta.events.push_back({ MatchEventType::FOOD, static_cast<uint16_t>(slot), pos });
+}
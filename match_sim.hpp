@@ -0,0 +1,130 @@
+/**
+ * @file match_sim.hpp
+ * @brief Headless simulation of one board shared by many snakes.
+ * @details MatchSim runs the multiplayer rules: every tick each snake turns,
+ * tails that do not eat move away, and new heads that hit a wall, an
+ * obstacle, a body or another new head die. Dead snakes leave the board and
+ * respawn a little later, and eaten food reappears on a free cell. Rather
+ * than whole snakes, each tick is described by a MatchDelta of small events
+ * (a head added, a tail removed, a snake died or spawned, a food moved),
+ * which is what the server sends to its clients. A client keeps a MatchSim
+ * of its own and apply()s the deltas it receives, so both sides hold the
+ * same board without the client ever running the rules. Like SnakeSim it
+ * has no Raylib dependency.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef MATCH_SIM_HPP
+#define MATCH_SIM_HPP
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+#include "snake_sim.hpp"
+#include "occupancy_grid.hpp"
+#include "free_cell_set.hpp"
+#include "level.hpp"
+#include "rng.hpp"
+
+enum class MatchEventType : uint8_t {
+    HEAD = 1,  // Snake id grew a new head at pos
+    TAIL,      // Snake id dropped its last segment
+    DIED,      // Snake id left the board; it respawns later. Snapshots send it for snakes still waiting to spawn
+    SPAWN,     // Snake id appeared with its head at pos, heading up, body in the two cells below
+    LEFT,      // Snake id left the match for good
+    FOOD,      // Food slot id moved to pos; x < 0 while no cell was free
+    SEGMENT    // Snake id gained a segment at pos behind its tail; only sent in snapshots
+};
+
+struct MatchEvent {
+    MatchEventType type;
+    uint16_t id;       // Snake id, or food slot for FOOD
+    Position pos;
+};
+
+// Everything that changed in one tick, in the order it has to be applied
+struct MatchDelta {
+    uint32_t tick = 0;
+    std::vector<MatchEvent> events;
+};
+
+struct MatchSnake {
+    bool joined = false;           // The id is taken by a player
+    bool alive = false;            // On the board; false while waiting to respawn
+    Direction direction = Direction::UP;  // On clients, derived from the last two segments
+    Direction requested = Direction::UP;
+    std::deque<Position> body;
+    uint32_t respawnAt = 0;        // Tick from which a snake off the board may spawn again
+
+    // Work fields of the tick in progress
+    Position next = { 0, 0 };
+    bool eats = false;
+    bool dies = false;
+
+    int getScore() const { return body.size() > 3 ? static_cast<int>(body.size() - 3) * SnakeSim::FOOD_SCORE : 0; }
+};
+
+class MatchSim {
+public:
+    static constexpr size_t MAX_SNAKES = 1024;
+    static constexpr uint32_t RESPAWN_TICKS = 20;
+    static constexpr int SPAWN_ATTEMPTS = 32;
+
+    MatchSim(int width = SnakeSim::DEFAULT_WIDTH, int height = SnakeSim::DEFAULT_HEIGHT, size_t foodCount = 1);
+
+    // Board setup; both clear every snake and food
+    void resize(int width, int height);
+    void setLevel(const Level& level);
+    void setObstacles(const std::vector<Position>& layout);
+    void seed(uint64_t value) { rng.seed(value); }
+
+    // Server side
+    int addSnake();                      // Id of the new snake, or -1 when the match is full
+    void removeSnake(uint16_t id, MatchDelta& delta);
+    void setDirection(uint16_t id, Direction direction);
+    void step(MatchDelta& delta);        // Advances one tick and describes it in delta
+    void snapshot(MatchDelta& delta) const; // Events that rebuild every snake and food on an empty board
+
+    // Client side: replays a delta or snapshot; false if an event does not fit the board
+    bool apply(const MatchDelta& delta);
+
+    // Accessors
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    uint32_t getTicks() const { return ticks; }
+    const std::vector<Position>& getObstacles() const { return obstacles; }
+    const std::vector<Position>& getFoods() const { return foods; }
+    const std::vector<MatchSnake>& getSnakes() const { return snakes; }
+    size_t getPlayerCount() const { return playerCount; }
+    uint32_t getLayoutVersion() const { return layoutVersion; }  // Changes whenever size or obstacles change
+
+private:
+    int width;
+    int height;
+    size_t foodCount;
+    std::vector<Position> obstacles;
+    std::vector<Position> foods;         // One slot per food
+    std::vector<MatchSnake> snakes;      // Indexed by id
+    OccupancyGrid occupied;              // Obstacles and every snake segment
+    OccupancyGrid foodCells;
+    FreeCellSet freeCells;               // Cells neither occupied nor holding food
+    std::vector<uint32_t> headClaims;    // Tick in which a new head last entered each cell
+    std::vector<uint16_t> headOwners;    // Snake that entered it
+    size_t playerCount;
+    uint32_t ticks;
+    uint32_t layoutVersion;
+    Rng rng;
+
+    size_t cellIndex(Position pos) const { return static_cast<size_t>(pos.y) * width + pos.x; }
+    bool isInside(Position pos) const { return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height; }
+    void occupy(Position pos);
+    void vacate(Position pos);
+    void clearBody(MatchSnake& snake);
+    bool spawnSnake(uint16_t id);
+    void placeFood(size_t slot, Position pos);
+    void respawnFood(size_t slot, MatchDelta& delta);
+};
+
+#endif // MATCH_SIM_HPP
@@ -0,0 +1,165 @@
+/**
+ * @file net_client.cpp
+ * @brief Implementation of the game's connection to snake_server.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "net_client.hpp"
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Constructor: Starts disconnected
+NetClient::NetClient() : fd(-1), joined(false), snakeId(0) {}
+
+// Destructor: Closes the connection
+NetClient::~NetClient() {
+    disconnect();
+}
+
+// Resolves the address, connects (blocking), sends HELLO and switches the socket to non-blocking
+bool NetClient::connect(const std::string& address, const std::string& name, std::string& error) {
+#ifdef _WIN32
+    (void)address;
+    (void)name;
+    error = "network play is not supported on this platform";
+    return false;
+#else
+    disconnect();
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+        error = "expected HOST:PORT, got " + address;
+        return false;
+    }
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    int status = getaddrinfo(host.c_str(), port.c_str(), &hints, &results);
+    if (status != 0) {
+        error = host + ": " + gai_strerror(status);
+        return false;
+    }
+    for (addrinfo* result = results; result && fd < 0; result = result->ai_next) {
+        fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, result->ai_addr, result->ai_addrlen) < 0) {
+            error = std::strerror(errno);
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(results);
+    if (fd < 0) return false;
+
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    encodeHello(out, name);
+    if (!sendPending()) {
+        error = "connection closed";
+        disconnect();
+        return false;
+    }
+    return true;
+#endif
+}
+
+// Closes the socket and forgets the match
+void NetClient::disconnect() {
+#ifndef _WIN32
+    if (fd >= 0) close(fd);
+#endif
+    fd = -1;
+    joined = false;
+    reader = FrameReader();
+    out.clear();
+}
+
+// Drains the socket and applies each complete frame to match
+int NetClient::poll(MatchSim& match) {
+#ifdef _WIN32
+    (void)match;
+    return -1;
+#else
+    if (fd < 0) return -1;
+    if (!sendPending()) {
+        disconnect();
+        return -1;
+    }
+
+    int ticks = 0;
+    char buffer[16384];
+    for (;;) {
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            disconnect();
+            return -1;
+        }
+        if (received < 0) break;
+        reader.append(buffer, static_cast<size_t>(received));
+
+        MessageType type;
+        std::string_view payload;
+        while (reader.next(type, payload)) {
+            bool ok = false;
+            if (type == MessageType::WELCOME) {
+                ok = decodeWelcome(payload, snakeId, match, delta);
+                joined = ok;
+            } else if (type == MessageType::TICK && joined) {
+                ok = decodeTick(payload, delta) && match.apply(delta);
+                ++ticks;
+            }
+            if (!ok) {
+                disconnect();
+                return -1;
+            }
+        }
+        if (reader.hasFailed()) {
+            disconnect();
+            return -1;
+        }
+    }
+    return ticks;
+#endif
+}
+
+// Queues a TURN frame; it is written right away unless the socket is full
+void NetClient::sendTurn(Direction direction) {
+    if (fd < 0) return;
+    encodeTurn(out, direction);
+    if (!sendPending()) disconnect();
+}
+
+// Writes as much of the outgoing buffer as the socket takes; false if the connection is gone
+bool NetClient::sendPending() {
+#ifdef _WIN32
+    return false;
+#else
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t written = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    out.erase(0, sent);
+    return true;
+#endif
+}
@@ -0,0 +1,52 @@
+/**
+ * @file net_client.hpp
+ * @brief Game-side connection to snake_server.
+ * @details connect() opens a TCP connection and sends HELLO; from then on
+ * the socket is non-blocking and poll(), called once per frame, applies
+ * every WELCOME and TICK that has arrived to a mirrored MatchSim, which the
+ * game draws instead of its own simulation. Turns go out as TURN frames.
+ * POSIX sockets only; on other platforms connect() reports that network
+ * play is unavailable.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef NET_CLIENT_HPP
+#define NET_CLIENT_HPP
+
+#include <string>
+#include <cstdint>
+#include "match_sim.hpp"
+#include "net_protocol.hpp"
+
+class NetClient {
+public:
+    NetClient();
+    ~NetClient();
+    NetClient(const NetClient&) = delete;
+    NetClient& operator=(const NetClient&) = delete;
+
+    // Connects to "host:port" and joins as name; on failure error says why
+    bool connect(const std::string& address, const std::string& name, std::string& error);
+    void disconnect();
+
+    // Applies every frame received since the last call; returns the number of ticks, or -1 once disconnected
+    int poll(MatchSim& match);
+    void sendTurn(Direction direction);
+
+    bool isConnected() const { return fd >= 0; }
+    bool hasJoined() const { return joined; }       // WELCOME has arrived
+    uint16_t getSnakeId() const { return snakeId; }
+
+private:
+    int fd;
+    bool joined;
+    uint16_t snakeId;
+    FrameReader reader;
+    MatchDelta delta;
+    std::string out;
+
+    bool sendPending();
+};
+
+#endif // NET_CLIENT_HPP
@@ -0,0 +1,198 @@
+/**
+ * @file net_protocol.cpp
+ * @brief Implementation of the multiplayer wire format.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "net_protocol.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace {
+
+const size_t EVENT_SIZE = 7;
+const size_t DELTA_HEADER_SIZE = 8;
+
+void putU8(std::string& out, uint8_t value) { out.push_back(static_cast<char>(value)); }
+
+void putU16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void putU32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>((value >> shift) & 0xFF));
+}
+
+// Bounds-checked little-endian reader over a payload
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data(data), pos(0) {}
+
+    bool has(size_t count) const { return data.size() - pos >= count; }
+    bool atEnd() const { return pos == data.size(); }
+    uint8_t u8() { return static_cast<uint8_t>(data[pos++]); }
+    uint16_t u16() { uint16_t value = static_cast<uint16_t>(u8()); return static_cast<uint16_t>(value | u8() << 8); }
+    uint32_t u32() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8) value |= static_cast<uint32_t>(u8()) << shift;
+        return value;
+    }
+    std::string_view bytes(size_t count) { std::string_view view = data.substr(pos, count); pos += count; return view; }
+
+private:
+    std::string_view data;
+    size_t pos;
+};
+
+// Reserves a frame header and returns its offset; finishFrame() fills in the length
+size_t beginFrame(std::string& out, MessageType type) {
+    size_t start = out.size();
+    putU32(out, 0);
+    putU8(out, static_cast<uint8_t>(type));
+    return start;
+}
+
+void finishFrame(std::string& out, size_t start) {
+    uint32_t length = static_cast<uint32_t>(out.size() - start - FRAME_HEADER_SIZE);
+    for (int i = 0; i < 4; ++i) out[start + i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+}
+
+void putDelta(std::string& out, const MatchDelta& delta) {
+    putU32(out, delta.tick);
+    putU32(out, static_cast<uint32_t>(delta.events.size()));
+    for (const auto& event : delta.events) {
+        putU8(out, static_cast<uint8_t>(event.type));
+        putU16(out, event.id);
+        putU16(out, static_cast<uint16_t>(event.pos.x));
+        putU16(out, static_cast<uint16_t>(event.pos.y));
+    }
+}
+
+bool readDelta(Reader& in, MatchDelta& delta) {
+    if (!in.has(DELTA_HEADER_SIZE)) return false;
+    delta.tick = in.u32();
+    uint32_t count = in.u32();
+    if (!in.has(static_cast<size_t>(count) * EVENT_SIZE)) return false;
+    delta.events.clear();
+    delta.events.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        MatchEvent event;
+        event.type = static_cast<MatchEventType>(in.u8());
+        event.id = in.u16();
+        event.pos.x = static_cast<int16_t>(in.u16());
+        event.pos.y = static_cast<int16_t>(in.u16());
+        delta.events.push_back(event);
+    }
+    return in.atEnd();
+}
+
+} // namespace
+
+void encodeHello(std::string& out, const std::string& name) {
+    size_t start = beginFrame(out, MessageType::HELLO);
+    size_t length = std::min(name.size(), MAX_NAME_LENGTH);
+    putU8(out, static_cast<uint8_t>(length));
+    out.append(name, 0, length);
+    finishFrame(out, start);
+}
+
+void encodeTurn(std::string& out, Direction direction) {
+    size_t start = beginFrame(out, MessageType::TURN);
+    putU8(out, static_cast<uint8_t>(direction));
+    finishFrame(out, start);
+}
+
+// The board and a snapshot of it; scratch holds the snapshot events so repeated welcomes reuse it
+void encodeWelcome(std::string& out, uint16_t snakeId, const MatchSim& match, MatchDelta& scratch) {
+    size_t start = beginFrame(out, MessageType::WELCOME);
+    putU16(out, snakeId);
+    putU16(out, static_cast<uint16_t>(match.getWidth()));
+    putU16(out, static_cast<uint16_t>(match.getHeight()));
+    putU32(out, static_cast<uint32_t>(match.getObstacles().size()));
+    for (const auto& pos : match.getObstacles()) {
+        putU16(out, static_cast<uint16_t>(pos.x));
+        putU16(out, static_cast<uint16_t>(pos.y));
+    }
+    scratch.events.clear();
+    match.snapshot(scratch);
+    putDelta(out, scratch);
+    finishFrame(out, start);
+}
+
+void encodeTick(std::string& out, const MatchDelta& delta) {
+    size_t start = beginFrame(out, MessageType::TICK);
+    putDelta(out, delta);
+    finishFrame(out, start);
+}
+
+bool decodeHello(std::string_view payload, std::string& name) {
+    Reader in(payload);
+    if (!in.has(1)) return false;
+    size_t length = in.u8();
+    if (length > MAX_NAME_LENGTH || !in.has(length)) return false;
+    name.assign(in.bytes(length));
+    return in.atEnd();
+}
+
+bool decodeTurn(std::string_view payload, Direction& direction) {
+    Reader in(payload);
+    if (!in.has(1)) return false;
+    uint8_t value = in.u8();
+    if (value > static_cast<uint8_t>(Direction::RIGHT) || !in.atEnd()) return false;
+    direction = static_cast<Direction>(value);
+    return true;
+}
+
+// Rebuilds match from a welcome: resized, obstacles set, then the snapshot applied
+bool decodeWelcome(std::string_view payload, uint16_t& snakeId, MatchSim& match, MatchDelta& scratch) {
+    Reader in(payload);
+    if (!in.has(10)) return false;
+    snakeId = in.u16();
+    int width = in.u16();
+    int height = in.u16();
+    uint32_t count = in.u32();
+    if (width < SnakeSim::MIN_GRID_SIZE || width > SnakeSim::MAX_GRID_SIZE ||
+        height < SnakeSim::MIN_GRID_SIZE || height > SnakeSim::MAX_GRID_SIZE) return false;
+    if (!in.has(static_cast<size_t>(count) * 4)) return false;
+
+    std::vector<Position> obstacles(count);
+    for (auto& pos : obstacles) {
+        pos.x = static_cast<int16_t>(in.u16());
+        pos.y = static_cast<int16_t>(in.u16());
+    }
+    match.resize(width, height);
+    match.setObstacles(obstacles);
+    return readDelta(in, scratch) && match.apply(scratch);
+}
+
+bool decodeTick(std::string_view payload, MatchDelta& delta) {
+    Reader in(payload);
+    return readDelta(in, delta);
+}
+
+// Buffers incoming bytes, first dropping the frames already handed out
+void FrameReader::append(const char* data, size_t size) {
+    if (readPos > 0) {
+        buffer.erase(0, readPos);
+        readPos = 0;
+    }
+    buffer.append(data, size);
+}
+
+bool FrameReader::next(MessageType& type, std::string_view& payload) {
+    if (failed || buffer.size() - readPos < FRAME_HEADER_SIZE) return false;
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(buffer.data() + readPos);
+    uint32_t length = header[0] | header[1] << 8 | header[2] << 16 | static_cast<uint32_t>(header[3]) << 24;
+    if (length > maxFrameSize) {
+        failed = true;
+        return false;
+    }
+    if (buffer.size() - readPos - FRAME_HEADER_SIZE < length) return false;
+
+    type = static_cast<MessageType>(header[4]);
+    payload = std::string_view(buffer.data() + readPos + FRAME_HEADER_SIZE, length);
+    readPos += FRAME_HEADER_SIZE + length;
+    return true;
+}
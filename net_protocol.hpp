@@ -0,0 +1,67 @@
+/**
+ * @file net_protocol.hpp
+ * @brief Wire format between snake_server and networked game clients.
+ * @details Every message is a frame: a little-endian u32 payload length, a
+ * u8 message type, then the payload. A client sends HELLO with its player
+ * name once and TURN whenever it turns. The server answers HELLO with
+ * WELCOME (the client's snake id, the board, its obstacles and a snapshot
+ * of every snake and food) and then sends one TICK per simulation tick
+ * holding only that tick's MatchDelta, 7 bytes per event, so the traffic
+ * grows with what moved rather than with the length of the snakes. The
+ * same TICK bytes go to every client, so the server encodes each tick once.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef NET_PROTOCOL_HPP
+#define NET_PROTOCOL_HPP
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "match_sim.hpp"
+
+enum class MessageType : uint8_t {
+    HELLO = 1,  // Client: u8 name length, name
+    TURN,       // Client: u8 direction
+    WELCOME,    // Server: u16 snake id, u16 width, u16 height, u32 obstacle count, obstacles, snapshot delta
+    TICK        // Server: delta
+};
+
+constexpr size_t FRAME_HEADER_SIZE = 5;
+constexpr uint32_t MAX_FRAME_SIZE = 64u << 20;  // Covers a welcome for a full 4096x4096 board; the server's send cap exempts it
+constexpr size_t MAX_NAME_LENGTH = 32;
+
+// Appends one complete frame to out
+void encodeHello(std::string& out, const std::string& name);
+void encodeTurn(std::string& out, Direction direction);
+void encodeWelcome(std::string& out, uint16_t snakeId, const MatchSim& match, MatchDelta& scratch);
+void encodeTick(std::string& out, const MatchDelta& delta);
+
+// Payload decoders; false when the payload is malformed
+bool decodeHello(std::string_view payload, std::string& name);
+bool decodeTurn(std::string_view payload, Direction& direction);
+bool decodeWelcome(std::string_view payload, uint16_t& snakeId, MatchSim& match, MatchDelta& scratch);
+bool decodeTick(std::string_view payload, MatchDelta& delta);
+
+/**
+ * @brief Splits a byte stream into frames as the bytes arrive.
+ */
+class FrameReader {
+public:
+    explicit FrameReader(uint32_t maxFrameSize = MAX_FRAME_SIZE) : maxFrameSize(maxFrameSize) {}
+
+    void append(const char* data, size_t size);
+    // Returns the next complete frame; the payload stays valid until the next append()
+    bool next(MessageType& type, std::string_view& payload);
+    bool hasFailed() const { return failed; }  // A frame header announced more than maxFrameSize
+
+private:
+    uint32_t maxFrameSize;
+    std::string buffer;
+    size_t readPos = 0;
+    bool failed = false;
+};
+
+#endif // NET_PROTOCOL_HPP
@@ -0,0 +1,46 @@
+/**
+ * @file occupancy_grid.hpp
+ * @brief Bitboard recording which cells of the board are occupied.
+ * @details One bit per cell, packed into 64-bit words in row-major order.
+ * SnakeSim keeps it in sync with the snake and obstacles so collision tests
+ * are a single bit lookup instead of a scan over every segment.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef OCCUPANCY_GRID_HPP
+#define OCCUPANCY_GRID_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+class OccupancyGrid {
+public:
+    explicit OccupancyGrid(size_t cellCount)
+        : cellCount(cellCount), words((cellCount + 63) / 64, 0) {}
+
+    bool test(size_t cell) const { return (words[cell >> 6] >> (cell & 63)) & 1u; }
+    void set(size_t cell) { words[cell >> 6] |= uint64_t(1) << (cell & 63); }
+    void clear(size_t cell) { words[cell >> 6] &= ~(uint64_t(1) << (cell & 63)); }
+    void clearAll() { std::fill(words.begin(), words.end(), 0); }
+
+    // Copies another grid of the same size without reallocating
+    void assign(const OccupancyGrid& other) {
+        std::copy(other.words.begin(), other.words.end(), words.begin());
+    }
+
+    size_t size() const { return cellCount; }
+
+    // Raw words, for bulk loading and saving of level bitmaps
+    size_t wordCount() const { return words.size(); }
+    uint64_t* data() { return words.data(); }
+    const uint64_t* data() const { return words.data(); }
+
+private:
+    size_t cellCount;
+    std::vector<uint64_t> words;
+};
+
+#endif // OCCUPANCY_GRID_HPP
@@ -0,0 +1,141 @@
+/**
+ * @file persistence.cpp
+ * @brief Implementation of the background file writer.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "persistence.hpp"
+#include <fstream>
+#include <cstdio>
+
+// Constructor: Starts the worker thread
+PersistenceWorker::PersistenceWorker()
+    : busy(false), stopping(false), writes(0), coalesced(0), failures(0) {
+    thread = std::thread(&PersistenceWorker::run, this);
+}
+
+// Destructor: Drains the queue, then stops the worker
+PersistenceWorker::~PersistenceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+// Queues a write, replacing a queued one for the same path
+void PersistenceWorker::submit(const std::string& path, Producer produce) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool replaced = false;
+        for (auto& job : pending) {
+            if (job.path == path) {
+                job.produce = std::move(produce);
+                job.tail.clear();
+                job.append = false;
+                replaced = true;
+                ++coalesced;
+                break;
+            }
+        }
+        if (!replaced) pending.push_back({path, std::move(produce), std::string(), false});
+    }
+    wake.notify_one();
+}
+
+// Queues bytes for the end of a file; joins a queued job for the same path
+// A queued full write still happens first, with the bytes added to what it produces
+void PersistenceWorker::append(const std::string& path, std::string bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool joined = false;
+        for (auto& job : pending) {
+            if (job.path == path) {
+                job.tail += bytes;
+                joined = true;
+                ++coalesced;
+                break;
+            }
+        }
+        if (!joined) pending.push_back({path, Producer(), std::move(bytes), true});
+    }
+    wake.notify_one();
+}
+
+// Waits until every submitted write has reached the disk
+void PersistenceWorker::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pending.empty() && !busy; });
+}
+
+uint64_t PersistenceWorker::getWrites() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writes;
+}
+
+uint64_t PersistenceWorker::getCoalesced() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return coalesced;
+}
+
+uint64_t PersistenceWorker::getFailures() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failures;
+}
+
+// Worker loop: takes the oldest job, produces and writes it outside the lock
+void PersistenceWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty()) break;  // Only reached when stopping
+
+        Job job = std::move(pending.front());
+        pending.erase(pending.begin());
+        busy = true;
+        lock.unlock();
+
+        std::string contents = job.produce ? job.produce() : std::string();
+        contents += job.tail;
+        bool ok = job.append ? appendToFile(job.path, contents) : writeFileAtomic(job.path, contents);
+
+        lock.lock();
+        busy = false;
+        ++writes;
+        if (!ok) ++failures;
+        if (pending.empty()) idle.notify_all();
+    }
+    idle.notify_all();
+}
+
+// The rename replaces the target in one step, so readers see the old or the new file
+bool writeFileAtomic(const std::string& path, const std::string& contents) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.flush();
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Appends in one write call, so a crash can at worst cut the last record short
+bool appendToFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) return false;
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    file.flush();
+    return static_cast<bool>(file);
+}
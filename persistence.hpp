@@ -0,0 +1,74 @@
+/**
+ * @file persistence.hpp
+ * @brief Background file writer for scores and other small save files.
+ * @details The game thread hands the worker a producer for a file's new
+ * contents; the worker runs it (so any reading of the old file also happens
+ * off the game thread), writes the result to a temporary file and renames it
+ * over the target, so a crash never leaves a half-written file. A producer
+ * that is still queued when a newer one arrives for the same path is
+ * replaced, which coalesces bursts of saves into one write. Producers must
+ * therefore write the complete, latest state of their file. Appends are the
+ * exception: they add bytes to the end of a log file, and queued appends to
+ * one path are concatenated rather than replaced.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef PERSISTENCE_HPP
+#define PERSISTENCE_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+class PersistenceWorker {
+public:
+    using Producer = std::function<std::string()>;
+
+    PersistenceWorker();
+    ~PersistenceWorker();  // Finishes every queued write before returning
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    void submit(const std::string& path, Producer produce);
+    void append(const std::string& path, std::string bytes);
+    void flush();  // Blocks until the queue is empty and no write is running
+
+    uint64_t getWrites() const;
+    uint64_t getCoalesced() const;
+    uint64_t getFailures() const;
+
+private:
+    struct Job {
+        std::string path;
+        Producer produce;  // Full contents, or empty for a pure append
+        std::string tail;  // Bytes appended after whatever produce returns
+        bool append;       // Add to the file instead of replacing it
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::vector<Job> pending;  // Oldest first, one entry per path
+    bool busy;
+    bool stopping;
+    uint64_t writes;
+    uint64_t coalesced;
+    uint64_t failures;
+    std::thread thread;
+
+    void run();
+};
+
+// Writes contents to path via a temporary file and a rename; returns false on failure
+bool writeFileAtomic(const std::string& path, const std::string& contents);
+
+// Appends bytes to path, creating it if needed; returns false on failure
+bool appendToFile(const std::string& path, const std::string& bytes);
+
+#endif // PERSISTENCE_HPP
@@ -0,0 +1,133 @@
+/**
+ * @file profiler.cpp
+ * @brief Implementation of the frame profiler.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "profiler.hpp"
+#include <fstream>
+#include <algorithm>
+
+namespace {
+
+const char* PHASE_NAMES[] = { "input", "update", "draw", "present" };
+
+} // namespace
+
+// Constructor: Reserves the whole sample ring up front so profiling does not allocate per frame
+FrameProfiler::FrameProfiler()
+    : samples(MAX_SAMPLES), next(0), count(0), current(), phase(ProfilePhase::INPUT),
+      frameAllocations(0), roundAllocations(0), frameTicks(0), inFrame(false) {}
+
+// Starts timing a frame with the input phase
+void FrameProfiler::beginFrame() {
+    current = FrameSample();
+    frameTicks = 0;
+    frameAllocations = allocationCount();
+    phase = ProfilePhase::INPUT;
+    phaseStart = Clock::now();
+    inFrame = true;
+}
+
+// Closes the running phase and starts timing the given one
+void FrameProfiler::mark(ProfilePhase newPhase) {
+    if (!inFrame) return;
+    Clock::time_point now = Clock::now();
+    current.phaseMs[static_cast<int>(phase)] += std::chrono::duration<float, std::milli>(now - phaseStart).count();
+    phase = newPhase;
+    phaseStart = now;
+}
+
+// Closes the frame and stores its sample, overwriting the oldest one when full
+void FrameProfiler::endFrame() {
+    if (!inFrame) return;
+    mark(phase);
+    current.ticks = frameTicks;
+    current.allocations = static_cast<uint32_t>(allocationCount() - frameAllocations);
+    samples[next] = current;
+    next = (next + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+    inFrame = false;
+}
+
+// Returns the sample recorded age frames ago (0 is the latest)
+const FrameSample& FrameProfiler::sample(size_t age) const {
+    return samples[(next + samples.size() - 1 - age) % samples.size()];
+}
+
+// Averages and maxima over the most recent frames
+ProfileSummary FrameProfiler::summarize(size_t lastFrames) const {
+    ProfileSummary summary = ProfileSummary();
+    summary.frames = std::min(lastFrames, count);
+    if (summary.frames == 0) return summary;
+
+    uint64_t ticks = 0;
+    uint64_t allocs = 0;
+    for (size_t age = 0; age < summary.frames; ++age) {
+        const FrameSample& s = sample(age);
+        float frameMs = 0.0f;
+        for (int p = 0; p < static_cast<int>(ProfilePhase::COUNT); ++p) {
+            summary.averageMs[p] += s.phaseMs[p];
+            summary.maxMs[p] = std::max(summary.maxMs[p], s.phaseMs[p]);
+            frameMs += s.phaseMs[p];
+        }
+        summary.averageFrameMs += frameMs;
+        summary.maxFrameMs = std::max(summary.maxFrameMs, frameMs);
+        ticks += s.ticks;
+        allocs += s.allocations;
+    }
+
+    float frames = static_cast<float>(summary.frames);
+    for (int p = 0; p < static_cast<int>(ProfilePhase::COUNT); ++p) summary.averageMs[p] /= frames;
+    summary.averageFrameMs /= frames;
+    summary.ticksPerFrame = ticks / frames;
+    summary.allocationsPerFrame = allocs / frames;
+    return summary;
+}
+
+// Returns the lower-case name used in overlays and exports
+const char* FrameProfiler::getPhaseName(ProfilePhase p) const {
+    return PHASE_NAMES[static_cast<int>(p)];
+}
+
+// Writes the kept samples, oldest first, as CSV or as JSON with a summary
+bool FrameProfiler::exportTo(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) return false;
+
+    const int phases = static_cast<int>(ProfilePhase::COUNT);
+    bool json = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+    if (!json) {
+        file << "frame";
+        for (int p = 0; p < phases; ++p) file << "," << PHASE_NAMES[p] << "_ms";
+        file << ",ticks,allocations\n";
+        for (size_t i = 0; i < count; ++i) {
+            const FrameSample& s = sample(count - 1 - i);
+            file << i;
+            for (int p = 0; p < phases; ++p) file << "," << s.phaseMs[p];
+            file << "," << s.ticks << "," << s.allocations << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+
+    ProfileSummary summary = summarize(count);
+    file << "{\n  \"frames\": " << summary.frames << ",\n  \"summary\": {";
+    for (int p = 0; p < phases; ++p) {
+        file << "\n    \"" << PHASE_NAMES[p] << "\": { \"avg_ms\": " << summary.averageMs[p]
+             << ", \"max_ms\": " << summary.maxMs[p] << " },";
+    }
+    file << "\n    \"frame\": { \"avg_ms\": " << summary.averageFrameMs << ", \"max_ms\": " << summary.maxFrameMs << " },"
+         << "\n    \"ticks_per_frame\": " << summary.ticksPerFrame
+         << ",\n    \"allocations_per_frame\": " << summary.allocationsPerFrame << "\n  },\n  \"samples\": [";
+    for (size_t i = 0; i < count; ++i) {
+        const FrameSample& s = sample(count - 1 - i);
+        file << (i ? ",\n    [" : "\n    [");
+        for (int p = 0; p < phases; ++p) file << s.phaseMs[p] << ", ";
+        file << s.ticks << ", " << s.allocations << "]";
+    }
+    file << "\n  ],\n  \"columns\": [";
+    for (int p = 0; p < phases; ++p) file << "\"" << PHASE_NAMES[p] << "_ms\", ";
+    file << "\"ticks\", \"allocations\"]\n}\n";
+    return static_cast<bool>(file);
+}
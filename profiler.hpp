@@ -0,0 +1,88 @@
+/**
+ * @file profiler.hpp
+ * @brief Per-frame timing, tick and allocation counters for the game loop.
+ * @details The frame is split into the phases of Game::run: input handling,
+ * simulation update, draw submission and present (EndDrawing, which also
+ * covers the buffer swap and the frame cap). Each phase is timed with a
+ * steady clock; the simulation ticks and the game thread's heap allocations
+ * (see alloc_counter.hpp; zero unless built with PROFILE=1) made during the
+ * frame are counted alongside. The last MAX_SAMPLES frames are kept so they
+ * can be summarised on screen and exported as CSV or JSON.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "alloc_counter.hpp"
+
+enum class ProfilePhase {
+    INPUT,
+    UPDATE,
+    DRAW,
+    PRESENT,
+    COUNT
+};
+
+struct FrameSample {
+    float phaseMs[static_cast<int>(ProfilePhase::COUNT)];
+    uint32_t ticks;         // Simulation ticks run during the frame
+    uint32_t allocations;   // Heap allocations made during the frame
+};
+
+struct ProfileSummary {
+    float averageMs[static_cast<int>(ProfilePhase::COUNT)];
+    float maxMs[static_cast<int>(ProfilePhase::COUNT)];
+    float averageFrameMs;
+    float maxFrameMs;
+    float ticksPerFrame;
+    float allocationsPerFrame;
+    size_t frames;
+};
+
+class FrameProfiler {
+public:
+    static constexpr size_t MAX_SAMPLES = 36000;  // Ten minutes at 60 FPS
+
+    FrameProfiler();
+
+    // Frame boundaries and phase switches; each mark ends the previous phase
+    void beginFrame();
+    void mark(ProfilePhase phase);
+    void endFrame();
+    void countTick() { ++frameTicks; }
+    // Rounds: allocations are also totalled from the last beginRound() on, for the overlay
+    void beginRound() { roundAllocations = allocationCount(); }
+    uint64_t getRoundAllocations() const { return allocationCount() - roundAllocations; }
+
+    ProfileSummary summarize(size_t lastFrames) const;
+    size_t getSampleCount() const { return count; }
+    const char* getPhaseName(ProfilePhase phase) const;
+
+    // Writes every kept sample; the format follows the extension (.json, otherwise CSV)
+    bool exportTo(const std::string& filename) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<FrameSample> samples;  // Ring buffer of the most recent frames
+    size_t next;
+    size_t count;
+    FrameSample current;
+    ProfilePhase phase;
+    Clock::time_point phaseStart;
+    uint64_t frameAllocations;
+    uint64_t roundAllocations;
+    uint32_t frameTicks;
+    bool inFrame;
+
+    const FrameSample& sample(size_t age) const;
+};
+
+#endif // PROFILER_HPP
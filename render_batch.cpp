@@ -0,0 +1,61 @@
+/**
+ * @file render_batch.cpp
+ * @brief Implementation of the batched cell renderer.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "render_batch.hpp"
+#include "rlgl.h"
+#include <cmath>
+
+// Constructor: Precomputes the circle outline shared by every glow
+CellBatch::CellBatch() {
+    for (int i = 0; i <= CIRCLE_SEGMENTS; ++i) {
+        float angle = 2.0f * PI * i / CIRCLE_SEGMENTS;
+        unitCircle[i] = { sinf(angle), cosf(angle) };
+    }
+    primitives.reserve(1024);
+}
+
+// Queues an axis-aligned rectangle
+void CellBatch::addRect(float x, float y, float width, float height, Color color) {
+    primitives.push_back({ false, x, y, width, height, color });
+}
+
+// Queues a filled circle
+void CellBatch::addCircle(float centerX, float centerY, float radius, Color color) {
+    primitives.push_back({ true, centerX, centerY, radius, 0.0f, color });
+}
+
+// Emits every queued primitive as one triangle stream and empties the queue
+// Vertex order matches raylib's own shape functions so face culling keeps them
+void CellBatch::flush() {
+    if (primitives.empty()) return;
+
+    rlBegin(RL_TRIANGLES);
+    for (const auto& p : primitives) {
+        rlColor4ub(p.color.r, p.color.g, p.color.b, p.color.a);
+        if (p.circle) {
+            rlCheckRenderBatchLimit(3 * CIRCLE_SEGMENTS);
+            for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+                rlVertex2f(p.x, p.y);
+                rlVertex2f(p.x + unitCircle[i + 1].x * p.width, p.y + unitCircle[i + 1].y * p.width);
+                rlVertex2f(p.x + unitCircle[i].x * p.width, p.y + unitCircle[i].y * p.width);
+            }
+        } else {
+            rlCheckRenderBatchLimit(6);
+            float right = p.x + p.width;
+            float bottom = p.y + p.height;
+            rlVertex2f(p.x, p.y);
+            rlVertex2f(p.x, bottom);
+            rlVertex2f(right, bottom);
+            rlVertex2f(p.x, p.y);
+            rlVertex2f(right, bottom);
+            rlVertex2f(right, p.y);
+        }
+    }
+    rlEnd();
+
+    primitives.clear();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file render_batch.hpp
+ * @brief Collects the play field's rectangles and circles into one rlgl submission.
+ * @details Instead of one immediate-mode DrawRectangle/DrawCircle call per
+ * cell, the field queues primitives here during the frame and flush() emits
+ * them as a single triangle stream, in the order they were added so alpha
+ * blending is unchanged. rlgl only splits the stream when its vertex buffer
+ * fills, so the number of GPU submissions no longer grows with snake length.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef RENDER_BATCH_HPP
+#define RENDER_BATCH_HPP
+
+#include <vector>
+#include <cstddef>
+#include "raylib.h"
+
+class CellBatch {
+public:
+    static constexpr int CIRCLE_SEGMENTS = 24;
+
+    CellBatch();
+
+    void addRect(float x, float y, float width, float height, Color color);
+    void addCircle(float centerX, float centerY, float radius, Color color);
+    void flush();
+    size_t size() const { return primitives.size(); }
+
+private:
+    struct Primitive {
+        bool circle;
+        float x, y;       // Top-left corner, or centre for circles
+        float width;      // Radius for circles
+        float height;
+        Color color;
+    };
+
+    std::vector<Primitive> primitives;  // Cleared, not freed, on flush
+    Vector2 unitCircle[CIRCLE_SEGMENTS + 1];
+};
+
+#endif // RENDER_BATCH_HPP
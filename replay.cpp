@@ -0,0 +1,199 @@
+/**
+ * @file replay.cpp
+ * @brief Implementation of replay recording, file format and playback.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "replay.hpp"
+#include <fstream>
+#include <cstring>
+
+namespace {
+
+constexpr char REPLAY_MAGIC[4] = {'S', 'N', 'K', 'R'};
+constexpr uint8_t REPLAY_VERSION = 1;
+constexpr uint32_t NO_CHANGE = UINT32_MAX;
+
+// Little-endian helpers so replays are portable between machines
+void writeUint(std::ofstream& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+bool readUint(std::ifstream& in, uint64_t& value, int bytes) {
+    value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        int byte = in.get();
+        if (byte == EOF) return false;
+        value |= static_cast<uint64_t>(byte) << (8 * i);
+    }
+    return true;
+}
+
+// Bytes between the read position and the end of the file
+uint64_t remainingBytes(std::ifstream& in) {
+    std::streampos here = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(here);
+    return here < 0 || end < here ? 0 : static_cast<uint64_t>(end - here);
+}
+
+} // namespace
+
+// Reserves the event log and obstacle copy for the largest round expected
+void ReplayRecorder::reserve(size_t eventBytes, size_t obstacles) {
+    replay.events.reserve(eventBytes);
+    replay.obstacles.reserve(obstacles);
+}
+
+// Starts a new recording for a round that was just reset
+// The layout is copied into the buffers kept from earlier rounds
+void ReplayRecorder::begin(uint64_t seed, const SnakeSim& sim) {
+    replay.seed = seed;
+    replay.width = sim.getWidth();
+    replay.height = sim.getHeight();
+    replay.obstacles = sim.getObstacles();
+    replay.events.clear();
+    replay.ticks = 0;
+    replay.score = 0;
+    lastDirection = sim.getDirection();
+    lastTick = 0;
+}
+
+// Records the direction fed to the simulation on a tick; only changes are stored
+void ReplayRecorder::record(uint32_t tick, Direction direction) {
+    if (direction == lastDirection) return;
+    uint64_t value = (static_cast<uint64_t>(tick - lastTick) << 2) | static_cast<uint64_t>(direction);
+    while (value >= 0x80) {
+        replay.events.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    replay.events.push_back(static_cast<uint8_t>(value));
+    lastDirection = direction;
+    lastTick = tick;
+}
+
+// Stores the outcome of the recorded round
+void ReplayRecorder::finish(const SnakeSim& sim) {
+    replay.ticks = sim.getTicks();
+    replay.score = sim.getScore();
+}
+
+// Constructor: Prepares playback from the first tick
+ReplayPlayer::ReplayPlayer(const Replay& replay) : replay(replay) {
+    rewind();
+}
+
+// Restarts playback from the beginning of the replay
+void ReplayPlayer::rewind() {
+    cursor = 0;
+    eventTick = 0;
+    current = Direction::UP;
+    pending = Direction::UP;
+    readEvent();
+}
+
+// Returns the direction to feed the simulation on the given tick
+// Ticks must be requested in increasing order
+Direction ReplayPlayer::directionFor(uint32_t tick) {
+    while (tick >= nextChange) {
+        current = pending;
+        readEvent();
+    }
+    return current;
+}
+
+// Decodes the next change into pending; returns false at the end of the stream
+bool ReplayPlayer::readEvent() {
+    uint64_t value = 0;
+    for (int shift = 0; cursor < replay.events.size() && shift < 64; shift += 7) {
+        uint8_t byte = replay.events[cursor++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            eventTick += static_cast<uint32_t>(value >> 2);
+            nextChange = eventTick;
+            pending = static_cast<Direction>(value & 3);
+            return true;
+        }
+    }
+    nextChange = NO_CHANGE;
+    return false;
+}
+
+// Writes a replay in the binary SNKR format
+bool saveReplay(const Replay& replay, const std::string& filename) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) return false;
+
+    out.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeUint(out, REPLAY_VERSION, 1);
+    writeUint(out, static_cast<uint64_t>(replay.width), 2);
+    writeUint(out, static_cast<uint64_t>(replay.height), 2);
+    writeUint(out, replay.seed, 8);
+    writeUint(out, replay.ticks, 4);
+    writeUint(out, static_cast<uint32_t>(replay.score), 4);
+    writeUint(out, replay.obstacles.size(), 4);
+    for (const auto& obs : replay.obstacles) {
+        writeUint(out, static_cast<uint16_t>(obs.x), 2);
+        writeUint(out, static_cast<uint16_t>(obs.y), 2);
+    }
+    writeUint(out, replay.events.size(), 4);
+    out.write(reinterpret_cast<const char*>(replay.events.data()), replay.events.size());
+    return static_cast<bool>(out);
+}
+
+// Reads a replay written by saveReplay
+// Counts are checked against the bytes left in the file before anything is allocated for them,
+// and a board SnakeSim would clamp or an obstacle off the board rejects the file
+bool loadReplay(const std::string& filename, Replay& replay) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0) return false;
+
+    uint64_t version, width, height, seed, ticks, score, count;
+    if (!readUint(in, version, 1) || version != REPLAY_VERSION) return false;
+    if (!readUint(in, width, 2) || !readUint(in, height, 2) || !readUint(in, seed, 8)) return false;
+    if (!readUint(in, ticks, 4) || !readUint(in, score, 4) || !readUint(in, count, 4)) return false;
+    if (width < SnakeSim::MIN_GRID_SIZE || width > SnakeSim::MAX_GRID_SIZE) return false;
+    if (height < SnakeSim::MIN_GRID_SIZE || height > SnakeSim::MAX_GRID_SIZE) return false;
+
+    replay.width = static_cast<int>(width);
+    replay.height = static_cast<int>(height);
+    replay.seed = seed;
+    replay.ticks = static_cast<uint32_t>(ticks);
+    replay.score = static_cast<int32_t>(static_cast<uint32_t>(score));
+
+    replay.obstacles.clear();
+    if (count * 4 > remainingBytes(in)) return false;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t x, y;
+        if (!readUint(in, x, 2) || !readUint(in, y, 2) || x >= width || y >= height) return false;
+        replay.obstacles.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y)});
+    }
+
+    if (!readUint(in, count, 4) || count > remainingBytes(in)) return false;
+    replay.events.resize(count);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(replay.events.data()), count));
+}
+
+// Reruns the recorded round; valid only if it ends on the recorded tick with the recorded score
+ReplayCheck verifyReplay(const Replay& replay) {
+    SnakeSim sim(replay.width, replay.height);
+    sim.setObstacles(replay.obstacles);
+    sim.seed(replay.seed);
+    sim.reset();
+
+    ReplayPlayer player(replay);
+    StepResult result = StepResult::MOVED;
+    while (sim.getTicks() < replay.ticks) {
+        result = sim.step(player.directionFor(sim.getTicks() + 1));
+        if (result == StepResult::DIED || result == StepResult::CLEARED) break;
+    }
+
+    bool ended = result == StepResult::DIED || result == StepResult::CLEARED;
+    bool valid = ended && sim.getTicks() == replay.ticks && sim.getScore() == replay.score;
+    return {valid, sim.getScore(), sim.getTicks()};
+}
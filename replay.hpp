@@ -0,0 +1,78 @@
+/**
+ * @file replay.hpp
+ * @brief Recording, storage and playback of game sessions.
+ * @details A replay holds everything needed to rerun a round exactly: the
+ * board size, obstacle layout and RNG seed, followed by the direction
+ * changes as (tick delta, direction) pairs packed into varints. Because the
+ * simulation is deterministic, feeding the recorded directions back into a
+ * SnakeSim reproduces the round, which lets scores be verified headless.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "snake_sim.hpp"
+
+struct Replay {
+    uint64_t seed = 0;
+    int width = SnakeSim::DEFAULT_WIDTH;
+    int height = SnakeSim::DEFAULT_HEIGHT;
+    std::vector<Position> obstacles;
+    std::vector<uint8_t> events;  // Varint of (ticks since last change << 2 | direction)
+    uint32_t ticks = 0;           // Length of the recorded round
+    int32_t score = 0;            // Final score of the recorded round
+};
+
+struct ReplayCheck {
+    bool valid;        // The replay reproduced its recorded score and length
+    int32_t score;     // Score reached on playback
+    uint32_t ticks;    // Ticks simulated on playback
+};
+
+class ReplayRecorder {
+public:
+    // Grows the buffers once up front, so recording rounds of up to this size does not allocate
+    void reserve(size_t eventBytes, size_t obstacles);
+    void begin(uint64_t seed, const SnakeSim& sim);
+    void record(uint32_t tick, Direction direction);
+    void finish(const SnakeSim& sim);
+    const Replay& getReplay() const { return replay; }
+
+private:
+    Replay replay;
+    Direction lastDirection = Direction::UP;
+    uint32_t lastTick = 0;
+};
+
+class ReplayPlayer {
+public:
+    explicit ReplayPlayer(const Replay& replay);
+    void rewind();
+    Direction directionFor(uint32_t tick);
+    bool isFinished(uint32_t tick) const { return tick >= replay.ticks; }
+
+private:
+    const Replay& replay;
+    size_t cursor;
+    uint32_t eventTick;   // Tick of the last decoded change
+    uint32_t nextChange;  // Tick at which pending takes effect
+    Direction current;
+    Direction pending;
+
+    bool readEvent();
+};
+
+// File I/O; both return false on failure, and loading also fails on a board or obstacle the game could not play
+bool saveReplay(const Replay& replay, const std::string& filename);
+bool loadReplay(const std::string& filename, Replay& replay);
+
+// Reruns a replay at full speed without rendering
+ReplayCheck verifyReplay(const Replay& replay);
+
+#endif // REPLAY_HPP
@@ -0,0 +1,66 @@
+/**
+ * @file rng.hpp
+ * @brief Small, fast, seedable pseudo-random number generator.
+ * @details Xoshiro256** seeded through SplitMix64, with Lemire's
+ * multiply-and-reject method for unbiased bounded integers. Every game and
+ * simulation owns its own instance, so there is no global state or locking
+ * and any run can be reproduced from its seed.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+
+// One SplitMix64 step; also used to derive independent seeds from a base seed
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+class Rng {
+public:
+    explicit Rng(uint64_t seedValue = 0) { seed(seedValue); }
+
+    void seed(uint64_t value) {
+        uint64_t state = value;
+        for (auto& word : s) word = splitMix64(state);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Returns a uniformly distributed integer in [0, bound) without modulo bias
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif // RNG_HPP
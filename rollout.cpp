@@ -0,0 +1,160 @@
+/**
+ * @file rollout.cpp
+ * @brief Implementation of the work-stealing rollout scheduler.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "rollout.hpp"
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+
+namespace {
+
+struct EpisodeRange {
+    uint64_t begin;
+    uint64_t end;
+};
+
+// One queue per worker, padded so neighbouring locks do not share a cache line
+struct alignas(64) WorkQueue {
+    std::mutex mutex;
+    std::deque<EpisodeRange> chunks;
+};
+
+class RolloutWorker : public EpisodeSource {
+public:
+    RolloutWorker(size_t index, const RolloutConfig& config, std::vector<WorkQueue>& queues, RolloutResult& result)
+        : index(index), config(config), queues(queues), result(result),
+          local({0, 0}), laneEpisode(config.envsPerThread, 0), steals(0), ticks(0) {}
+
+    // Runs the worker's batch until every queue is drained
+    void run(const PolicyFactory& makePolicy) {
+        // The policy must exist before the batch asks this worker for its first episodes
+        policy = makePolicy(config.envsPerThread);
+        BatchSim batch(config.envsPerThread, config.width, config.height, config.obstacles, this);
+        batch.setMaxEpisodeTicks(config.maxEpisodeTicks);
+        std::vector<Direction> actions(batch.size(), Direction::UP);
+
+        while (batch.getAliveCount() > 0) {
+            policy->act(batch, actions.data());
+            batch.stepAll(actions.data());
+        }
+        ticks = batch.getTotalTicks();
+    }
+
+    bool nextEpisode(size_t env, uint64_t& seed) override {
+        if (local.begin == local.end && !claimChunk()) return false;
+        uint64_t episode = local.begin++;
+        laneEpisode[env] = episode;
+        seed = episodeSeed(config.seed, episode);
+        policy->beginEpisode(env, seed);
+        return true;
+    }
+
+    void episodeEnded(size_t env, int32_t score, uint32_t episodeTicks) override {
+        // Episode indices are unique, so workers never write the same slot
+        result.scores[laneEpisode[env]] = score;
+        result.ticks[laneEpisode[env]] = episodeTicks;
+    }
+
+    uint64_t getSteals() const { return steals; }
+    uint64_t getTicks() const { return ticks; }
+
+private:
+    size_t index;
+    const RolloutConfig& config;
+    std::vector<WorkQueue>& queues;
+    RolloutResult& result;
+    std::unique_ptr<RolloutPolicy> policy;
+    EpisodeRange local;
+    std::vector<uint64_t> laneEpisode;
+    uint64_t steals;
+    uint64_t ticks;
+
+    // Takes the next chunk from the own queue, or steals one from the back of another
+    bool claimChunk() {
+        {
+            std::lock_guard<std::mutex> lock(queues[index].mutex);
+            if (!queues[index].chunks.empty()) {
+                local = queues[index].chunks.front();
+                queues[index].chunks.pop_front();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            WorkQueue& victim = queues[(index + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.chunks.empty()) {
+                local = victim.chunks.back();
+                victim.chunks.pop_back();
+                ++steals;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+// Random moves for every live environment, drawn from that environment's own engine
+void RandomPolicy::act(const BatchSim& batch, Direction* actions) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        actions[i] = static_cast<Direction>(engines[i].next() >> 62);
+    }
+}
+
+// SplitMix64 over the base seed and episode index
+uint64_t episodeSeed(uint64_t base, uint64_t episode) {
+    uint64_t state = base + episode * 0x9E3779B97F4A7C15ull;
+    return splitMix64(state);
+}
+
+// Deals episode chunks to the workers, runs them, and gathers the results
+RolloutResult runRollouts(const RolloutConfig& config, const PolicyFactory& makePolicy) {
+    unsigned threadCount = config.threads > 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    uint64_t chunkSize = std::max<uint64_t>(1, config.chunkSize);
+
+    RolloutResult result;
+    result.threads = threadCount;
+    result.scores.assign(config.episodes, 0);
+    result.ticks.assign(config.episodes, 0);
+
+    // Contiguous blocks per worker keep early work local; stealing evens out the tail
+    std::vector<WorkQueue> queues(threadCount);
+    uint64_t chunkCount = (config.episodes + chunkSize - 1) / chunkSize;
+    for (uint64_t chunk = 0; chunk < chunkCount; ++chunk) {
+        uint64_t begin = chunk * chunkSize;
+        uint64_t end = std::min(config.episodes, begin + chunkSize);
+        queues[chunk * threadCount / chunkCount].chunks.push_back({begin, end});
+    }
+
+    std::vector<std::unique_ptr<RolloutWorker>> workers;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<RolloutWorker>(i, config, queues, result));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    try {
+        for (auto& worker : workers) {
+            threads.emplace_back([&worker, &makePolicy]() { worker->run(makePolicy); });
+        }
+    } catch (...) {
+        // The workers already started must be joined before the error can leave
+        for (auto& thread : threads) thread.join();
+        throw;
+    }
+    for (auto& thread : threads) thread.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& worker : workers) {
+        result.totalTicks += worker->getTicks();
+        result.steals += worker->getSteals();
+    }
+    return result;
+}
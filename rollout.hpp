@@ -0,0 +1,79 @@
+/**
+ * @file rollout.hpp
+ * @brief Multithreaded batch rollouts with work stealing.
+ * @details Episodes are split into chunks and dealt to per-thread queues.
+ * Each worker owns a BatchSim, a policy and its random state, and only
+ * touches shared state when it needs a new chunk: first from its own
+ * queue, then by stealing from the back of another worker's queue. Episode
+ * seeds are derived from the episode index, so results do not depend on the
+ * number of threads or on which worker ran an episode.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef ROLLOUT_HPP
+#define ROLLOUT_HPP
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include "rng.hpp"
+#include "batch_sim.hpp"
+
+/**
+ * @brief Chooses actions for every environment of a worker's batch.
+ */
+class RolloutPolicy {
+public:
+    virtual ~RolloutPolicy() = default;
+    // Called when env starts a new episode, with that episode's seed
+    virtual void beginEpisode(size_t env, uint64_t seed) { (void)env; (void)seed; }
+    // Fills one action per environment of the batch
+    virtual void act(const BatchSim& batch, Direction* actions) = 0;
+};
+
+/**
+ * @brief Uniformly random moves, reseeded per episode for reproducibility.
+ */
+class RandomPolicy : public RolloutPolicy {
+public:
+    explicit RandomPolicy(size_t envCount) : engines(envCount) {}
+    void beginEpisode(size_t env, uint64_t seed) override { engines[env].seed(~seed); }
+    void act(const BatchSim& batch, Direction* actions) override;
+
+private:
+    std::vector<Rng> engines;
+};
+
+using PolicyFactory = std::function<std::unique_ptr<RolloutPolicy>(size_t envCount)>;
+
+struct RolloutConfig {
+    uint64_t episodes = 1000;
+    unsigned threads = 0;              // 0 uses every hardware thread
+    size_t envsPerThread = 64;         // Lanes in each worker's BatchSim
+    uint64_t chunkSize = 16;           // Episodes claimed per queue operation
+    uint32_t maxEpisodeTicks = 100000; // Episodes are truncated after this many ticks
+    uint64_t seed = 1;
+    int width = SnakeSim::DEFAULT_WIDTH;
+    int height = SnakeSim::DEFAULT_HEIGHT;
+    std::vector<Position> obstacles;
+};
+
+struct RolloutResult {
+    std::vector<int32_t> scores;       // Final score, indexed by episode
+    std::vector<uint32_t> ticks;       // Episode length, indexed by episode
+    uint64_t totalTicks = 0;
+    uint64_t steals = 0;
+    double seconds = 0.0;
+    unsigned threads = 0;
+};
+
+// Returns the seed used for episode index within a run seeded with base
+uint64_t episodeSeed(uint64_t base, uint64_t episode);
+
+// Runs config.episodes episodes across worker threads and collects their results
+RolloutResult runRollouts(const RolloutConfig& config, const PolicyFactory& makePolicy);
+
+#endif // ROLLOUT_HPP
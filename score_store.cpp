@@ -0,0 +1,200 @@
+/**
+ * @file score_store.cpp
+ * @brief Implementation of the indexed leaderboard store.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "score_store.hpp"
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+const char MAGIC[4] = {'S', 'N', 'K', 'S'};
+const uint8_t VERSION = 1;
+const size_t HEADER_SIZE = sizeof(MAGIC) + 1;
+const size_t COMPACT_SLACK = 1024;  // Superseded records tolerated before compacting
+
+std::string header() {
+    std::string bytes(MAGIC, sizeof(MAGIC));
+    bytes.push_back(static_cast<char>(VERSION));
+    return bytes;
+}
+
+// One log record: name length byte, name, little-endian 32-bit score
+void encodeRecord(std::string& out, const std::string& name, int score) {
+    uint32_t value = static_cast<uint32_t>(score);
+    out.push_back(static_cast<char>(name.size()));
+    out += name;
+    for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>((value >> shift) & 0xFF));
+}
+
+int32_t decodeScore(const std::string& data, size_t pos) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    return static_cast<int32_t>(value);
+}
+
+} // namespace
+
+// Constructor: Nothing is read until the first query
+ScoreStore::ScoreStore(const std::string& path, std::vector<std::string> legacyPaths)
+    : path(path), legacyPaths(std::move(legacyPaths)), writer(nullptr), loaded(false) {}
+
+// Raises the player's best and appends a record; lower scores change nothing
+bool ScoreStore::record(const std::string& name, int score) {
+    ensureLoaded();
+    std::string key = name.substr(0, MAX_NAME_LENGTH);
+    if (key.empty() || score <= getBest(key)) return false;
+
+    apply(key, score);
+    std::string bytes = index.fileStarted ? std::string() : header();
+    encodeRecord(bytes, key, score);
+    index.fileStarted = true;
+    ++index.logRecords;
+    write(bytes, false);
+    return true;
+}
+
+// Returns the best score recorded for a player
+int ScoreStore::getBest(const std::string& name) const {
+    ensureLoaded();
+    auto it = index.ids.find(name.substr(0, MAX_NAME_LENGTH));
+    return it == index.ids.end() ? 0 : index.scores[it->second];
+}
+
+// Returns the player's position on the leaderboard
+size_t ScoreStore::getRank(const std::string& name) const {
+    ensureLoaded();
+    auto it = index.ids.find(name.substr(0, MAX_NAME_LENGTH));
+    if (it == index.ids.end()) return 0;
+    return index.ranking.order_of_key({-index.scores[it->second], it->second}) + 1;
+}
+
+// Returns the best count players, best first
+std::vector<ScoreEntry> ScoreStore::top(size_t count) const {
+    std::vector<ScoreEntry> entries;
+    top(count, entries);
+    return entries;
+}
+
+// Same, into an existing list: names are assigned over the old ones, so a list that keeps its
+// size allocates nothing unless a name outgrows its string
+void ScoreStore::top(size_t count, std::vector<ScoreEntry>& entries) const {
+    ensureLoaded();
+    entries.resize(std::min(count, index.ranking.size()));
+    size_t i = 0;
+    for (auto it = index.ranking.begin(); i < entries.size(); ++it, ++i) {
+        entries[i].name = index.names[it->second];
+        entries[i].score = -it->first;
+    }
+}
+
+// Returns the number of players with a score
+size_t ScoreStore::size() const {
+    ensureLoaded();
+    return index.names.size();
+}
+
+// Returns the number of records in the file, superseded ones included
+size_t ScoreStore::getLogRecords() const {
+    ensureLoaded();
+    return index.logRecords;
+}
+
+// Rewrites the file with one record per player
+bool ScoreStore::compact() {
+    ensureLoaded();
+    index.logRecords = index.names.size();
+    index.fileStarted = true;
+    return write(serialize(), true);
+}
+
+// Loads the log on first use; queries are const, so the index is filled in place
+void ScoreStore::ensureLoaded() const {
+    if (!loaded) const_cast<ScoreStore*>(this)->load();
+}
+
+// Replays the log into the index, importing legacy scores when there is no log yet
+void ScoreStore::load() {
+    loaded = true;
+    index = Index();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        importLegacy();
+        return;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    if (data.size() < HEADER_SIZE || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0 ||
+        static_cast<uint8_t>(data[sizeof(MAGIC)]) != VERSION) {
+        // Keep an unreadable file for inspection rather than appending to it
+        std::rename(path.c_str(), (path + ".bad").c_str());
+        return;
+    }
+    index.fileStarted = true;
+
+    size_t pos = HEADER_SIZE;
+    while (pos < data.size()) {
+        size_t length = static_cast<uint8_t>(data[pos]);
+        if (pos + 1 + length + 4 > data.size()) break;  // Cut short by an interrupted append
+        apply(data.substr(pos + 1, length), decodeScore(data, pos + 1 + length));
+        ++index.logRecords;
+        pos += 1 + length + 4;
+    }
+
+    // A torn tail would misalign later appends, so it is dropped along with superseded records
+    if (pos != data.size() || index.logRecords > 2 * index.names.size() + COMPACT_SLACK) compact();
+}
+
+// Imports the best score per player from the old text score files
+void ScoreStore::importLegacy() {
+    for (const auto& legacyPath : legacyPaths) {
+        for (const auto& entry : readLeaderboard(legacyPath)) {
+            if (entry.score > 0) apply(entry.name.substr(0, MAX_NAME_LENGTH), entry.score);
+        }
+    }
+    if (!index.names.empty()) compact();
+}
+
+// Updates the index with a score, keeping the best per player
+void ScoreStore::apply(const std::string& name, int score) {
+    auto it = index.ids.find(name);
+    if (it != index.ids.end()) {
+        uint32_t id = it->second;
+        if (score <= index.scores[id]) return;
+        index.ranking.erase({-index.scores[id], id});
+        index.scores[id] = score;
+        index.ranking.insert({-score, id});
+        return;
+    }
+    uint32_t id = static_cast<uint32_t>(index.names.size());
+    index.names.push_back(name);
+    index.scores.push_back(score);
+    index.ids.emplace(name, id);
+    index.ranking.insert({-score, id});
+}
+
+// Builds a compacted file: the header and one record per player
+std::string ScoreStore::serialize() const {
+    std::string bytes = header();
+    for (size_t id = 0; id < index.names.size(); ++id) {
+        encodeRecord(bytes, index.names[id], index.scores[id]);
+    }
+    return bytes;
+}
+
+// Writes through the worker when there is one; queued appends follow a queued rewrite
+bool ScoreStore::write(const std::string& bytes, bool replace) {
+    if (writer) {
+        if (replace) writer->submit(path, [bytes]() { return bytes; });
+        else writer->append(path, bytes);
+        return true;
+    }
+    return replace ? writeFileAtomic(path, bytes) : appendToFile(path, bytes);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file score_store.hpp
+ * @brief Indexed leaderboard store for large numbers of players.
+ * @details Scores live in scores.db, a binary log: a "SNKS" header followed
+ * by (name length, name, score) records, one appended whenever a player
+ * beats their best. Loading replays the log into a hash index from name to
+ * player and an order-statistics tree ordered by score, so a player's best,
+ * rank and the top K entries are answered in O(1), O(log n) and
+ * O(K + log n) without touching the disk. The log is read lazily on the
+ * first query and compacted when superseded records dominate it. The old
+ * text score files (scores.txt, user_scores.txt) are imported the first
+ * time the store is opened.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef SCORE_STORE_HPP
+#define SCORE_STORE_HPP
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+#include "leaderboard.hpp"
+#include "persistence.hpp"
+
+class ScoreStore {
+public:
+    static constexpr size_t MAX_NAME_LENGTH = 255;
+
+    explicit ScoreStore(const std::string& path, std::vector<std::string> legacyPaths = {});
+
+    // Appends go through the worker when set, otherwise straight to the file
+    void setWriter(PersistenceWorker* worker) { writer = worker; }
+
+    void preload() { ensureLoaded(); }  // Reads the file now instead of on the first query
+
+    bool record(const std::string& name, int score);  // True when it raised the player's best
+    int getBest(const std::string& name) const;       // 0 for unknown players
+    size_t getRank(const std::string& name) const;    // 1-based, 0 for unknown players
+    std::vector<ScoreEntry> top(size_t count) const;
+    void top(size_t count, std::vector<ScoreEntry>& entries) const;  // Refills entries, reusing its storage
+    size_t size() const;
+    size_t getLogRecords() const;
+    bool compact();
+
+private:
+    // Keys are (-score, player) so the tree starts at the best score; ties go to the earlier player
+    using RankKey = std::pair<int, uint32_t>;
+    using RankTree = __gnu_pbds::tree<RankKey, __gnu_pbds::null_type, std::less<RankKey>,
+                                      __gnu_pbds::rb_tree_tag, __gnu_pbds::tree_order_statistics_node_update>;
+
+    struct Index {
+        std::vector<std::string> names;  // By player id
+        std::vector<int> scores;         // Best score by player id
+        std::unordered_map<std::string, uint32_t> ids;
+        RankTree ranking;
+        size_t logRecords = 0;           // Records in the file, superseded ones included
+        bool fileStarted = false;        // The file exists and has its header
+    };
+
+    std::string path;
+    std::vector<std::string> legacyPaths;  // "name score" text files imported when there is no log
+    PersistenceWorker* writer;
+    mutable Index index;
+    mutable bool loaded;
+
+    void ensureLoaded() const;
+    void load();
+    void importLegacy();
+    void apply(const std::string& name, int score);
+    std::string serialize() const;
+    bool write(const std::string& bytes, bool replace);
+};
+
+#endif // SCORE_STORE_HPP
@@ -0,0 +1,366 @@
+/**
+ * @file server.cpp
+ * @brief snake_server: the authoritative host for networked matches.
+ * @details One MatchSim runs at a fixed tick, driven by a timerfd. All
+ * sockets are non-blocking and served by a single epoll loop, so one core
+ * handles hundreds of clients: a client's HELLO gets a snake and a WELCOME
+ * snapshot, its TURN frames set that snake's direction, and after every
+ * tick the tick's delta is encoded once and queued to every joined client.
+ * A client whose unsent backlog of ticks grows past MAX_PENDING_BYTES is
+ * dropped rather than buffered without limit; the WELCOME, which for a big
+ * board can be far larger (up to MAX_FRAME_SIZE), is not counted against it. Linux only; needs no Raylib.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "match_sim.hpp"
+#include "net_protocol.hpp"
+#include "level.hpp"
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) { stopRequested = 1; }
+
+struct ServerConfig {
+    int port = 7777;
+    int width = 64;
+    int height = 48;
+    int tickMs = 100;
+    size_t foodCount = 8;
+    uint64_t seed = 0;
+    std::string levelPath;  // Optional obstacle map; a binary level also sets the board size
+};
+
+class MatchServer {
+public:
+    static constexpr size_t MAX_PENDING_BYTES = 1 << 20;  // Unsent tick bytes a slow client may fall behind by
+    static constexpr uint32_t MAX_CLIENT_FRAME = 64;      // Clients only send HELLO and TURN
+    static constexpr uint64_t MAX_CATCH_UP_TICKS = 4;     // Ticks run at once after a stall
+    static constexpr int MAX_EVENTS = 256;
+
+    explicit MatchServer(const ServerConfig& config);
+    ~MatchServer();
+    void run();
+
+private:
+    struct Client {
+        int fd = -1;
+        FrameReader reader{ MAX_CLIENT_FRAME };
+        std::string out;
+        size_t sent = 0;
+        bool waitingForWrite = false;  // EPOLLOUT is armed
+        size_t welcomeLeft = 0;        // Unsent bytes of the WELCOME, allowed on top of MAX_PENDING_BYTES
+        int snake = -1;                // Snake id once HELLO arrived
+        std::string name;
+    };
+
+    int listenFd;
+    int epollFd;
+    int timerFd;
+    MatchSim match;
+    MatchDelta delta;                  // Collects events until the next tick goes out
+    MatchDelta scratch;
+    std::string frame;
+    std::unordered_map<int, Client> clients;
+    std::vector<int> dropped;
+
+    void acceptClients();
+    bool readClient(Client& client);
+    bool handleFrame(Client& client, MessageType type, std::string_view payload);
+    bool queue(Client& client, const std::string& bytes);
+    bool flush(Client& client);
+    void dropClient(int fd);
+    void tick(uint64_t count);
+    void watch(int fd, uint32_t events, int op);
+};
+
+// Opens the listening socket, the tick timer and the epoll set
+MatchServer::MatchServer(const ServerConfig& config)
+    : listenFd(-1), epollFd(-1), timerFd(-1), match(config.width, config.height, config.foodCount) {
+    Level level;
+    if (!config.levelPath.empty()) {
+        if (!loadLevel(config.levelPath, config.width, config.height, level)) {
+            throw std::runtime_error("Could not load level: " + config.levelPath);
+        }
+        match.setLevel(level);
+    }
+    match.seed(config.seed);
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listenFd < 0) throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(config.port));
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        throw std::runtime_error("Could not listen on port " + std::to_string(config.port) + ": " + std::strerror(errno));
+    }
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    epollFd = epoll_create1(0);
+    if (timerFd < 0 || epollFd < 0) throw std::runtime_error(std::string("epoll/timerfd: ") + std::strerror(errno));
+    itimerspec interval{};
+    interval.it_interval.tv_sec = config.tickMs / 1000;
+    interval.it_interval.tv_nsec = (config.tickMs % 1000) * 1000000L;
+    interval.it_value = interval.it_interval;
+    timerfd_settime(timerFd, 0, &interval, nullptr);
+
+    watch(listenFd, EPOLLIN, EPOLL_CTL_ADD);
+    watch(timerFd, EPOLLIN, EPOLL_CTL_ADD);
+    std::cout << "Serving a " << match.getWidth() << "x" << match.getHeight() << " match on port " << config.port
+              << ", one tick every " << config.tickMs << " ms" << std::endl;
+}
+
+// Destructor: Closes every socket
+MatchServer::~MatchServer() {
+    for (auto& entry : clients) close(entry.first);
+    if (timerFd >= 0) close(timerFd);
+    if (epollFd >= 0) close(epollFd);
+    if (listenFd >= 0) close(listenFd);
+}
+
+// Serves until SIGINT or SIGTERM
+void MatchServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (!stopRequested) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("epoll_wait: ") + std::strerror(errno));
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptClients();
+            } else if (fd == timerFd) {
+                uint64_t expirations = 0;
+                if (read(timerFd, &expirations, sizeof(expirations)) == sizeof(expirations)) tick(expirations);
+            } else {
+                auto found = clients.find(fd);
+                if (found == clients.end()) continue;  // Dropped earlier in this batch
+                Client& client = found->second;
+                bool ok = true;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) ok = readClient(client);
+                if (ok && (events[i].events & EPOLLOUT)) ok = flush(client);
+                if (!ok) dropClient(fd);
+            }
+        }
+    }
+}
+
+// Accepts every pending connection
+void MatchServer::acceptClients() {
+    for (;;) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) return;  // EAGAIN once the backlog is empty; other errors leave it for the next wakeup
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        clients[fd].fd = fd;
+        watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+    }
+}
+
+// Reads everything available and handles each complete frame; false when the client must go
+bool MatchServer::readClient(Client& client) {
+    char buffer[4096];
+    for (;;) {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received == 0) return false;
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        client.reader.append(buffer, static_cast<size_t>(received));
+
+        MessageType type;
+        std::string_view payload;
+        while (client.reader.next(type, payload)) {
+            if (!handleFrame(client, type, payload)) return false;
+        }
+        if (client.reader.hasFailed()) return false;
+    }
+    return true;
+}
+
+// HELLO joins the match once; TURN steers the client's snake
+bool MatchServer::handleFrame(Client& client, MessageType type, std::string_view payload) {
+    if (type == MessageType::HELLO && client.snake < 0) {
+        if (!decodeHello(payload, client.name)) return false;
+        client.snake = match.addSnake();
+        if (client.snake < 0) return false;  // Match full
+        frame.clear();
+        encodeWelcome(frame, static_cast<uint16_t>(client.snake), match, scratch);
+        // Nothing is queued before the welcome, so it is the first welcomeLeft bytes to go out
+        client.welcomeLeft = frame.size();
+        std::cout << "'" << client.name << "' joined as snake " << client.snake
+                  << " (" << match.getPlayerCount() << " playing)" << std::endl;
+        return queue(client, frame);
+    }
+    if (type == MessageType::TURN && client.snake >= 0) {
+        Direction direction;
+        if (!decodeTurn(payload, direction)) return false;
+        match.setDirection(static_cast<uint16_t>(client.snake), direction);
+        return true;
+    }
+    return false;
+}
+
+// Appends bytes to the client's backlog and sends as much as the socket takes
+bool MatchServer::queue(Client& client, const std::string& bytes) {
+    if (client.out.size() - client.sent + bytes.size() > MAX_PENDING_BYTES + client.welcomeLeft) return false;
+    client.out += bytes;
+    return client.waitingForWrite || flush(client);
+}
+
+// Writes the backlog until the socket would block; EPOLLOUT is armed only while bytes remain
+bool MatchServer::flush(Client& client) {
+    while (client.sent < client.out.size()) {
+        ssize_t written = send(client.fd, client.out.data() + client.sent, client.out.size() - client.sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+            if (!client.waitingForWrite) watch(client.fd, EPOLLIN | EPOLLOUT, EPOLL_CTL_MOD);
+            client.waitingForWrite = true;
+            // Keep the buffer from creeping forward forever while a client lags
+            if (client.sent > MAX_PENDING_BYTES) {
+                client.out.erase(0, client.sent);
+                client.sent = 0;
+            }
+            return true;
+        }
+        client.sent += static_cast<size_t>(written);
+        client.welcomeLeft -= std::min(client.welcomeLeft, static_cast<size_t>(written));
+    }
+    client.out.clear();
+    client.sent = 0;
+    if (client.waitingForWrite) watch(client.fd, EPOLLIN, EPOLL_CTL_MOD);
+    client.waitingForWrite = false;
+    return true;
+}
+
+// Closes a connection; its snake leaves the board with the next tick
+void MatchServer::dropClient(int fd) {
+    auto found = clients.find(fd);
+    if (found == clients.end()) return;
+    if (found->second.snake >= 0) {
+        match.removeSnake(static_cast<uint16_t>(found->second.snake), delta);
+        std::cout << "'" << found->second.name << "' left (" << match.getPlayerCount() << " playing)" << std::endl;
+    }
+    close(fd);
+    clients.erase(found);
+}
+
+// Runs due ticks and sends each one's delta to every joined client
+void MatchServer::tick(uint64_t count) {
+    for (uint64_t i = 0; i < std::min(count, MAX_CATCH_UP_TICKS); ++i) {
+        match.step(delta);
+        frame.clear();
+        encodeTick(frame, delta);
+        delta.events.clear();
+
+        dropped.clear();
+        for (auto& entry : clients) {
+            if (entry.second.snake >= 0 && !queue(entry.second, frame)) dropped.push_back(entry.first);
+        }
+        for (int fd : dropped) dropClient(fd);
+    }
+}
+
+void MatchServer::watch(int fd, uint32_t events, int op) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, op, fd, &event);
+}
+
+/**
+ * @brief Prints the supported command-line options.
+ * @param program The name the program was invoked with.
+ */
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --port N      TCP port to listen on (default 7777)\n"
+              << "  --width N     Board width in cells (default 64)\n"
+              << "  --height N    Board height in cells (default 48)\n"
+              << "  --tick-ms N   Milliseconds per tick (default 100)\n"
+              << "  --food N      Food on the board at once (default 8)\n"
+              << "  --seed N      Seed for food and spawn placement\n"
+              << "  --level FILE  Obstacle map, binary or text\n";
+}
+
+/**
+ * @brief Parses command-line options into a server configuration.
+ * @return true if every argument was recognised, false otherwise.
+ */
+bool parseArguments(int argc, char* argv[], ServerConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            config.port = std::atoi(argv[++i]);
+        } else if (arg == "--width" && hasValue) {
+            config.width = std::atoi(argv[++i]);
+        } else if (arg == "--height" && hasValue) {
+            config.height = std::atoi(argv[++i]);
+        } else if (arg == "--tick-ms" && hasValue) {
+            config.tickMs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--food" && hasValue) {
+            config.foodCount = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--level" && hasValue) {
+            config.levelPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return config.port > 0 && config.port < 65536;
+}
+
+} // namespace
+
+/**
+ * @brief Parses options and serves a match until interrupted.
+ * @return 0 after a clean shutdown, 1 on error.
+ */
+int main(int argc, char* argv[]) {
+    ServerConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    try {
+        MatchServer server(config);
+        server.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
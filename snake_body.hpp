@@ -0,0 +1,66 @@
+/**
+ * @file snake_body.hpp
+ * @brief Fixed-capacity ring buffer holding the snake's segments.
+ * @details The buffer is allocated once, rounded up to a power of two so
+ * indices wrap with a mask, and stores compact 16-bit coordinates. Index 0
+ * is the head. Moving the snake is a push_front plus an optional pop_back
+ * and never allocates.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef SNAKE_BODY_HPP
+#define SNAKE_BODY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct Position {
+    int16_t x, y;
+    bool operator==(const Position& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+class SnakeBody {
+public:
+    // Capacity must cover every cell of the board plus the head that moves off it on death
+    explicit SnakeBody(size_t capacity)
+        : segments(roundUpPow2(capacity + 1)), mask(segments.size() - 1), head(0), length(0) {}
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    const Position& operator[](size_t i) const { return segments[(head + i) & mask]; }
+    const Position& front() const { return segments[head]; }
+    const Position& back() const { return segments[(head + length - 1) & mask]; }
+
+    void push_front(Position pos) {
+        head = (head - 1) & mask;
+        segments[head] = pos;
+        ++length;
+    }
+
+    void push_back(Position pos) {
+        segments[(head + length) & mask] = pos;
+        ++length;
+    }
+
+    void pop_back() { --length; }
+    void clear() { head = 0; length = 0; }
+
+private:
+    std::vector<Position> segments;
+    size_t mask;
+    size_t head;
+    size_t length;
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+};
+
+#endif // SNAKE_BODY_HPP
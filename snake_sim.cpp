@@ -0,0 +1,222 @@
+/**
+ * @file snake_sim.cpp
+ * @brief Implementation of the headless Snake simulation core.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#include "snake_sim.hpp"
+#include <algorithm>
+
+// Constructor: Creates an empty board with the snake in its starting position
+SnakeSim::SnakeSim(int width, int height)
+    : width(0), height(0), snake(0), food({0, 0}), foodPlaced(false),
+      obstacleCells(0), occupied(0), freeCells(0),
+      direction(Direction::UP), score(0), ticks(0), layoutVersion(0) {
+    resize(width, height);
+}
+
+// Changes the board dimensions, reallocating every per-cell structure once
+// Obstacles outside the new board or under its starting snake are dropped
+void SnakeSim::resize(int newWidth, int newHeight) {
+    width = std::max(MIN_GRID_SIZE, std::min(MAX_GRID_SIZE, newWidth));
+    height = std::max(MIN_GRID_SIZE, std::min(MAX_GRID_SIZE, newHeight));
+    size_t cellCount = static_cast<size_t>(width) * height;
+
+    snake = SnakeBody(cellCount);
+    obstacleCells = OccupancyGrid(cellCount);
+    occupied = OccupancyGrid(cellCount);
+    freeCells = FreeCellSet(cellCount);
+
+    // The start cells move with the board centre, so the kept layout goes through the same filter as a new one
+    std::vector<Position> layout;
+    layout.swap(obstacles);
+    setObstacles(layout);
+
+    reset();
+}
+
+// Resets the snake, score and food; obstacles are kept
+void SnakeSim::reset() {
+    initializeSnake();
+    generateFood();
+    score = 0;
+    ticks = 0;
+}
+
+// Advances the simulation by one tick in the requested direction
+StepResult SnakeSim::step(Direction requested) {
+    if (width == DEFAULT_WIDTH && height == DEFAULT_HEIGHT) {
+        return stepOn<DEFAULT_WIDTH, DEFAULT_HEIGHT>(requested);
+    }
+    return stepOn<0, 0>(requested);
+}
+
+// Step body, compiled once with the default board size baked in and once generic
+template <int W, int H>
+StepResult SnakeSim::stepOn(Direction requested) {
+    // Reversing onto the neck is ignored, matching the input filter of the game
+    bool reverse = (direction == Direction::UP && requested == Direction::DOWN) ||
+                   (direction == Direction::DOWN && requested == Direction::UP) ||
+                   (direction == Direction::LEFT && requested == Direction::RIGHT) ||
+                   (direction == Direction::RIGHT && requested == Direction::LEFT);
+    if (!reverse) direction = requested;
+    ++ticks;
+
+    moveSnake();
+
+    if (collides<W, H>(snake.front())) {
+        return StepResult::DIED;
+    }
+    return finishStep(foodPlaced && snake.front() == food);
+}
+
+// Tick with the heading, new head and its outcome already known; the head is pushed before
+// the occupancy test, exactly as in stepOn(), so a dead board looks the same either way
+StepResult SnakeSim::advance(Direction resolved, Position newHead, bool outside, bool eats) {
+    direction = resolved;
+    ++ticks;
+    snake.push_front(newHead);
+    if (outside || occupied.test(cellIndex(newHead))) {
+        return StepResult::DIED;
+    }
+    return finishStep(foodPlaced && eats);
+}
+
+// Second half of a tick once the new head survived: claims its cell, then eats or drops the tail
+StepResult SnakeSim::finishStep(bool eats) {
+    occupy(snake.front());
+    if (eats) {
+        score += FOOD_SCORE;
+        return generateFood() ? StepResult::ATE : StepResult::CLEARED;
+    }
+
+    vacate(snake.back());
+    snake.pop_back();
+    return StepResult::MOVED;
+}
+
+// Initializes the snake to starting position and direction
+void SnakeSim::initializeSnake() {
+    int16_t centerX = static_cast<int16_t>(width / 2);
+    int16_t centerY = static_cast<int16_t>(height / 2);
+    snake.clear();
+    snake.push_back({centerX, centerY});
+    snake.push_back({centerX, static_cast<int16_t>(centerY + 1)});
+    snake.push_back({centerX, static_cast<int16_t>(centerY + 2)});
+    direction = Direction::UP;
+
+    occupied.assign(obstacleCells);
+    freeCells.clear();
+    uint32_t cellCount = static_cast<uint32_t>(width) * height;
+    for (uint32_t cell = 0; cell < cellCount; ++cell) {
+        if (!occupied.test(cell)) freeCells.insert(cell);
+    }
+    for (size_t i = 0; i < snake.size(); ++i) occupy(snake[i]);
+}
+
+// Marks a cell as taken by the snake
+void SnakeSim::occupy(Position pos) {
+    size_t cell = cellIndex(pos);
+    occupied.set(cell);
+    freeCells.erase(static_cast<uint32_t>(cell));
+}
+
+// Returns a cell left by the snake to the free set
+void SnakeSim::vacate(Position pos) {
+    size_t cell = cellIndex(pos);
+    occupied.clear(cell);
+    freeCells.insert(static_cast<uint32_t>(cell));
+}
+
+// Generates food at a uniformly random empty position
+// Returns false when the board is full and no food could be placed
+bool SnakeSim::generateFood() {
+    foodPlaced = !freeCells.empty();
+    if (foodPlaced) {
+        uint32_t cell = freeCells.at(rng.nextBelow(static_cast<uint32_t>(freeCells.size())));
+        food = {static_cast<int16_t>(cell % width), static_cast<int16_t>(cell / width)};
+    }
+    return foodPlaced;
+}
+
+// Moves the snake in the current direction
+void SnakeSim::moveSnake() {
+    Position newHead = snake.front();
+    switch (direction) {
+        case Direction::UP:    newHead.y--; break;
+        case Direction::DOWN:  newHead.y++; break;
+        case Direction::LEFT:  newHead.x--; break;
+        case Direction::RIGHT: newHead.x++; break;
+    }
+    snake.push_front(newHead);
+}
+
+// Checks for collisions with walls, self, or obstacles
+bool SnakeSim::checkCollision() const {
+    return collides<0, 0>(snake.front());
+}
+
+// The new head is not yet marked, so any set bit under it is a body segment or obstacle
+template <int W, int H>
+bool SnakeSim::collides(Position head) const {
+    constexpr bool fixed = W > 0 && H > 0;
+    int boardWidth = fixed ? W : width;
+    int boardHeight = fixed ? H : height;
+    if (head.x < 0 || head.x >= boardWidth || head.y < 0 || head.y >= boardHeight) return true;
+    return occupied.test(static_cast<size_t>(head.y) * boardWidth + head.x);
+}
+
+// Loads a binary or text level; binary levels bring their own board size
+// The obstacles take effect on the next reset(); a missing file clears them
+bool SnakeSim::loadObstacles(const std::string& filename) {
+    Level level;
+    if (!loadLevel(filename, width, height, level)) {
+        setObstacles({});
+        return false;
+    }
+    setLevel(level);
+    return true;
+}
+
+// Replaces the obstacle layout; cells outside the board or under the starting snake are ignored
+void SnakeSim::setObstacles(const std::vector<Position>& layout) {
+    obstacles.clear();
+    obstacleCells.clearAll();
+    for (const auto& pos : layout) {
+        if (pos.x < 0 || pos.x >= width || pos.y < 0 || pos.y >= height || isStartCell(pos)) continue;
+        size_t cell = cellIndex(pos);
+        if (obstacleCells.test(cell)) continue;
+        obstacles.push_back(pos);
+        obstacleCells.set(cell);
+    }
+    ++layoutVersion;
+}
+
+// Copies a level's bitmap into the obstacle grid, resizing the board to match it first
+void SnakeSim::setLevel(const Level& level) {
+    if (level.width != width || level.height != height) resize(level.width, level.height);
+    obstacleCells.assign(level.cells);
+    for (int16_t dy = 0; dy < 3; ++dy) {
+        obstacleCells.clear(cellIndex({static_cast<int16_t>(width / 2), static_cast<int16_t>(height / 2 + dy)}));
+    }
+    collectObstacles();
+    ++layoutVersion;
+}
+
+// The snake starts on three cells of the centre column, which must stay free
+bool SnakeSim::isStartCell(Position pos) const {
+    return pos.x == width / 2 && pos.y >= height / 2 && pos.y <= height / 2 + 2;
+}
+
+// Rebuilds the obstacle list for rendering and replays from the set bits of the grid
+void SnakeSim::collectObstacles() {
+    obstacles.clear();
+    const uint64_t* words = obstacleCells.data();
+    for (size_t w = 0; w < obstacleCells.wordCount(); ++w) {
+        for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+            size_t cell = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+            obstacles.push_back({static_cast<int16_t>(cell % width), static_cast<int16_t>(cell / width)});
+        }
+    }
+}
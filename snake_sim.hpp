@@ -0,0 +1,108 @@
+/**
+ * @file snake_sim.hpp
+ * @brief Headless simulation core for the Snake game.
+ * @details SnakeSim owns the board, the snake, food and obstacles and advances
+ * them one tick at a time. It has no dependency on Raylib, so it can be stepped
+ * without a window for batch simulation, AI training and benchmarks.
+ * @author chmodxChironex
+ * @date 2025
+ */
+
+#ifndef SNAKE_SIM_HPP
+#define SNAKE_SIM_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "rng.hpp"
+#include "snake_body.hpp"
+#include "occupancy_grid.hpp"
+#include "free_cell_set.hpp"
+#include "level.hpp"
+
+enum class Direction {
+    UP, DOWN, LEFT, RIGHT
+};
+
+enum class StepResult {
+    MOVED,  // The snake advanced one cell
+    ATE,    // The snake advanced onto the food and grew
+    DIED,   // The snake hit a wall, itself or an obstacle
+    CLEARED // The snake ate the last food and no empty cell is left
+};
+
+class SnakeSim {
+public:
+    // Board Constants
+    static constexpr int DEFAULT_WIDTH = 30;
+    static constexpr int DEFAULT_HEIGHT = 20;
+    static constexpr int MIN_GRID_SIZE = 5;
+    static constexpr int MAX_GRID_SIZE = 4096;
+    static constexpr int FOOD_SCORE = 10;
+
+    SnakeSim(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+
+    // Simulation
+    void resize(int width, int height);
+    void seed(uint64_t value) { rng.seed(value); }
+    void reset();
+    StepResult step(Direction direction);
+    // Applies a tick whose heading and new head were worked out elsewhere, as BatchSim's kernels do
+    // for many boards at once; gives the same result as step() with the request they resolved
+    StepResult advance(Direction resolved, Position newHead, bool outside, bool eats);
+    bool loadObstacles(const std::string& filename);
+    void setObstacles(const std::vector<Position>& layout);
+    void setLevel(const Level& level);
+    void reserveObstacles(size_t count) { obstacles.reserve(count); }
+
+    // Step phases, used by step() and exposed for benchmarks
+    void moveSnake();
+    bool checkCollision() const;
+    bool generateFood();
+
+    // Accessors
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const SnakeBody& getSnake() const { return snake; }
+    const std::vector<Position>& getObstacles() const { return obstacles; }
+    Position getFood() const { return food; }
+    bool hasFood() const { return foodPlaced; }
+    Direction getDirection() const { return direction; }
+    int getScore() const { return score; }
+    uint32_t getTicks() const { return ticks; }
+    uint32_t getLayoutVersion() const { return layoutVersion; }  // Changes whenever size or obstacles change
+    // True for cells off the board or under the snake or an obstacle; moving there would end the round
+    bool isBlocked(Position pos) const {
+        return pos.x < 0 || pos.x >= width || pos.y < 0 || pos.y >= height || occupied.test(cellIndex(pos));
+    }
+
+private:
+    int width;
+    int height;
+    SnakeBody snake;
+    Position food;
+    bool foodPlaced;
+    std::vector<Position> obstacles;
+    OccupancyGrid obstacleCells;
+    OccupancyGrid occupied;
+    FreeCellSet freeCells;
+    Direction direction;
+    int score;
+    uint32_t ticks;
+    uint32_t layoutVersion;
+    Rng rng;
+
+    void initializeSnake();
+    void occupy(Position pos);
+    void vacate(Position pos);
+    bool isStartCell(Position pos) const;
+    void collectObstacles();
+    size_t cellIndex(Position pos) const { return static_cast<size_t>(pos.y) * width + pos.x; }
+
+    // Board-size specialized step; W and H are zero for the runtime-sized path
+    template <int W, int H> StepResult stepOn(Direction requested);
+    StepResult finishStep(bool eats);
+    template <int W, int H> bool collides(Position head) const;
+};
+
+#endif // SNAKE_SIM_HPP